@@ -0,0 +1,181 @@
+/*
+ * bme280_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "bme280_compensate.hpp"
+#include "cycles.hpp"
+
+/*
+ * bme280_compensate_fixed() against the float bme280_compensate(): random trimming parameters around the
+ * datasheet ones, random ADC values within the operating range (-40..85 C, 300..1100 hPa), the largest
+ * difference of each value, then the cycles per sample of both paths. exits 1 over the tolerances:
+ * T by the truncations of the datasheet algorithm (tolerance_t), P 0.0055 hPa, H 0.01 %RH.
+ * the host has an FPU, on the ESP32-C3 the float path goes through the soft-float routines.
+ * bme280_bench [--calibrations 1000] [--samples 1000] [--seed 1]
+ */
+using namespace sensors;
+
+constexpr double TOLERANCE_P = 0.0055; // hPa
+constexpr double TOLERANCE_H = 0.01;   // %RH
+
+// datasheet 8.2 and a typical humidity trimming
+const bme280_calib_t DATASHEET = {
+    .dig_T1 = 27504,
+    .dig_T2 = 26435,
+    .dig_T3 = -1000,
+    .dig_P1 = 36477,
+    .dig_P2 = -10685,
+    .dig_P3 = 3024,
+    .dig_P4 = 2855,
+    .dig_P5 = 140,
+    .dig_P6 = -7,
+    .dig_P7 = 15500,
+    .dig_P8 = -14600,
+    .dig_P9 = 6000,
+    .dig_H1 = 75,
+    .dig_H2 = 362,
+    .dig_H3 = 0,
+    .dig_H4 = 313,
+    .dig_H5 = 50,
+    .dig_H6 = 30,
+};
+
+// +-10% of the datasheet value, at least +-spread
+template<typename T>
+static T vary(std::mt19937& rng, T val, int spread) {
+    const int range = std::max(spread, abs(val) / 10);
+    return static_cast<T>(val + std::uniform_int_distribution<int>(-range, range)(rng));
+}
+
+static bme280_calib_t random_calib(std::mt19937& rng) {
+    auto res   = DATASHEET;
+    res.dig_T1 = vary(rng, res.dig_T1, 0);
+    res.dig_T2 = vary(rng, res.dig_T2, 0);
+    res.dig_T3 = vary(rng, res.dig_T3, 0);
+    res.dig_P1 = vary(rng, res.dig_P1, 0);
+    res.dig_P2 = vary(rng, res.dig_P2, 0);
+    res.dig_P3 = vary(rng, res.dig_P3, 0);
+    res.dig_P4 = vary(rng, res.dig_P4, 0);
+    res.dig_P5 = vary(rng, res.dig_P5, 20);
+    res.dig_P6 = vary(rng, res.dig_P6, 3);
+    res.dig_P7 = vary(rng, res.dig_P7, 0);
+    res.dig_P8 = vary(rng, res.dig_P8, 0);
+    res.dig_P9 = vary(rng, res.dig_P9, 0);
+    res.dig_H1 = vary(rng, res.dig_H1, 5);
+    res.dig_H2 = vary(rng, res.dig_H2, 0);
+    res.dig_H3 = vary(rng, res.dig_H3, 0);
+    res.dig_H4 = vary(rng, res.dig_H4, 0);
+    res.dig_H5 = vary(rng, res.dig_H5, 5);
+    res.dig_H6 = vary(rng, res.dig_H6, 3);
+    return res;
+}
+
+// uniform 20/16 bit ADC values, those out of the operating range by the float path are drawn again
+static bme280_raw_t random_raw(std::mt19937& rng, const bme280_calib_t& calib) {
+    std::uniform_int_distribution<int32_t> adc20(0, 0xFFFFF - 1);
+    std::uniform_int_distribution<int32_t> adc16(0, 0xFFFF);
+    for (;;) {
+        const bme280_raw_t raw = { .temperature = adc20(rng), .pressure = adc20(rng), .humidity = adc16(rng) };
+        const auto         val = bme280_compensate(calib, raw);
+        if (val.temperature >= -40 && val.temperature <= 85 && val.pressure >= 300 && val.pressure <= 1100) {
+            return raw;
+        }
+    }
+}
+
+/*
+ * C, the 0.01 C step of the output rounds by 0.005, adc_T >> 3 and the >> 11 of var1 truncate t_fine by up to
+ * (7/8 * dig_T2 / 2048 + 1), var2 by 1 more: 0.0076 with the datasheet dig_T2
+ */
+static double tolerance_t(const bme280_calib_t& calib) {
+    return 0.005 + (7. / 8 * calib.dig_T2 / 2048 + 2) / 5120 + 0.0001;
+}
+
+typedef struct {
+    double temperature = 0;
+    double pressure    = 0;
+    double humidity    = 0;
+    bool   over        = false; // of a tolerance
+} max_error_t;
+
+static void compare(const bme280_calib_t& calib, const bme280_raw_t& raw, max_error_t& err) {
+    const auto   ref = bme280_compensate(calib, raw);
+    const auto   val = to_bme280(bme280_compensate_fixed(calib, raw));
+    const double t   = fabs(val.temperature - ref.temperature);
+    const double p   = fabs(val.pressure - ref.pressure);
+    const double h   = fabs(val.humidity - ref.humidity);
+    err.temperature  = std::max(err.temperature, t);
+    err.pressure     = std::max(err.pressure, p);
+    err.humidity     = std::max(err.humidity, h);
+    err.over         = err.over || t > tolerance_t(calib) || p > TOLERANCE_P || h > TOLERANCE_H;
+}
+
+template<typename F>
+static double cycles_per_sample(const bme280_calib_t& calib, const std::vector<bme280_raw_t>& raws, F compensate) {
+    volatile float sink  = 0;
+    const uint64_t start = cycles();
+    for (const auto& raw : raws) {
+        sink = sink + compensate(calib, raw);
+    }
+    return double(cycles() - start) / raws.size();
+}
+
+int main(int argc, char* argv[]) {
+    int      calibrations = 1000;
+    int      samples      = 1000;
+    unsigned seed         = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string arg = argv[i];
+        if (arg == "--calibrations") {
+            calibrations = atoi(argv[i + 1]);
+        } else if (arg == "--samples") {
+            samples = atoi(argv[i + 1]);
+        } else if (arg == "--seed") {
+            seed = atoi(argv[i + 1]);
+        }
+    }
+    if (calibrations <= 0 || samples <= 0) {
+        fputs("bme280_bench [--calibrations 1000] [--samples 1000] [--seed 1]\n", stderr);
+        return 2;
+    }
+
+    // datasheet 8.2 example: 25.08 C, 100653 Pa
+    const auto example = bme280_compensate_fixed(DATASHEET, { .temperature = 519888, .pressure = 415148 });
+    const bool example_ok = example.temperature == 2508 && example.pressure / 256 == 100653;
+    printf("datasheet example %.2f C %u Pa %s\n", example.temperature / 100., example.pressure / 256,
+        example_ok ? "ok" : "FAILED");
+
+    std::mt19937              rng(seed);
+    max_error_t               err;
+    std::vector<bme280_raw_t> raws;
+    for (int i = 0; i < calibrations; i++) {
+        const auto calib = i ? random_calib(rng) : DATASHEET;
+        for (int j = 0; j < samples; j++) {
+            const auto raw = random_raw(rng, calib);
+            compare(calib, raw, err);
+            if (i == 0) {
+                raws.push_back(raw);
+            }
+        }
+    }
+    const bool accurate = !err.over;
+    printf("%d calibrations x %d samples, max |fixed - float|: T %.5f C, P %.5f hPa, H %.5f %%RH %s\n", calibrations,
+        samples, err.temperature, err.pressure, err.humidity, accurate ? "ok" : "FAILED");
+
+    const auto fixed = cycles_per_sample(DATASHEET, raws, [](const auto& calib, const auto& raw) {
+        return static_cast<float>(bme280_compensate_fixed(calib, raw).pressure);
+    });
+    const auto floating = cycles_per_sample(
+        DATASHEET, raws, [](const auto& calib, const auto& raw) { return bme280_compensate(calib, raw).pressure; });
+    printf("cycles/sample: fixed %.0f, float %.0f\n", fixed, floating);
+    return example_ok && accurate ? 0 : 1;
+}
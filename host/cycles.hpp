@@ -0,0 +1,22 @@
+/*
+ * cycles.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+// the time stamp counter of the host benchmarks where there is one, ns otherwise
+inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+#endif
+}
@@ -0,0 +1,33 @@
+/*
+ * bh1750.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "i2c_bus.h"
+
+#define BH1750_I2C_ADDRESS_DEFAULT 0x23
+
+typedef void* bh1750_handle_t;
+
+typedef enum {
+    BH1750_ONETIME_1LX_RES = 0x20,
+} bh1750_measure_mode_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// modelled at the driver level, see mock/i2c_bus.cpp
+bh1750_handle_t bh1750_create(i2c_bus_handle_t port, const uint8_t dev_addr);
+esp_err_t       bh1750_delete(bh1750_handle_t* sensor);
+esp_err_t       bh1750_power_on(bh1750_handle_t sensor);
+esp_err_t       bh1750_power_down(bh1750_handle_t sensor);
+esp_err_t       bh1750_set_measure_mode(bh1750_handle_t sensor, const bh1750_measure_mode_t cmd_measure);
+esp_err_t       bh1750_get_data(bh1750_handle_t sensor, float* const data);
+#ifdef __cplusplus
+}
+#endif
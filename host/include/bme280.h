@@ -0,0 +1,27 @@
+/*
+ * bme280.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+// the enums of the component, the wrapper talks to the registers through i2c_bus
+
+#define BME280_I2C_ADDRESS_DEFAULT 0x76
+
+typedef enum {
+    BME280_SAMPLING_NONE = 0,
+    BME280_SAMPLING_X1   = 1,
+    BME280_SAMPLING_X2   = 2,
+    BME280_SAMPLING_X4   = 3,
+    BME280_SAMPLING_X8   = 4,
+    BME280_SAMPLING_X16  = 5,
+} bme280_sampling;
+
+typedef enum {
+    BME280_MODE_SLEEP  = 0,
+    BME280_MODE_FORCED = 1,
+    BME280_MODE_NORMAL = 3,
+} bme280_sensor_mode;
@@ -0,0 +1,40 @@
+/*
+ * gpio.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_0  = 0,
+    GPIO_NUM_8  = 8,
+    GPIO_NUM_9  = 9,
+} gpio_num_t;
+
+typedef enum {
+    GPIO_MODE_DISABLE,
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+} gpio_mode_t;
+
+typedef enum {
+    GPIO_PULLUP_DISABLE,
+    GPIO_PULLUP_ENABLE,
+} gpio_pullup_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num);
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode);
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+esp_err_t gpio_sleep_sel_dis(gpio_num_t gpio_num);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+/*
+ * i2c.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driver/gpio.h"
+
+typedef int i2c_port_t;
+#define I2C_NUM_0 0
+
+typedef enum {
+    I2C_MODE_SLAVE,
+    I2C_MODE_MASTER,
+} i2c_mode_t;
+
+typedef struct {
+    i2c_mode_t    mode;
+    int           sda_io_num;
+    int           scl_io_num;
+    gpio_pullup_t sda_pullup_en;
+    gpio_pullup_t scl_pullup_en;
+    union {
+        struct {
+            uint32_t clk_speed;
+        } master;
+    };
+    uint32_t clk_flags;
+} i2c_config_t;
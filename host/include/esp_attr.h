@@ -0,0 +1,15 @@
+/*
+ * esp_attr.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+// RTC memory is a section of its own, the simulation carries it over the deep sleep
+#define RTC_DATA_ATTR __attribute__((section("rtc_data")))
+#define RTC_NOINIT_ATTR RTC_DATA_ATTR
+#define RTC_IRAM_ATTR
+#define RTC_RODATA_ATTR
+#define IRAM_ATTR
@@ -0,0 +1,32 @@
+/*
+ * esp_chip_info.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_bit_defs.h"
+
+#define CHIP_FEATURE_EMB_FLASH BIT(0)
+#define CHIP_FEATURE_WIFI_BGN BIT(1)
+#define CHIP_FEATURE_BLE BIT(4)
+#define CHIP_FEATURE_BT BIT(5)
+#define CHIP_FEATURE_IEEE802154 BIT(6)
+
+typedef struct {
+    int      model;
+    uint32_t features;
+    uint16_t revision;
+    uint8_t  cores;
+} esp_chip_info_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void esp_chip_info(esp_chip_info_t* out_info);
+#ifdef __cplusplus
+}
+#endif
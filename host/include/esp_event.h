@@ -0,0 +1,27 @@
+/*
+ * esp_event.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_event_base.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_netif_types.h"
+#include "esp_wifi_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// the handlers run on the "sys_evt" thread
+esp_err_t esp_event_loop_create_default(void);
+// ESP_ERR_INVALID_STATE without the default loop, as on the device
+esp_err_t esp_event_handler_register(esp_event_base_t base, int32_t id, esp_event_handler_t handler, void* arg);
+esp_err_t esp_event_post(esp_event_base_t base, int32_t id, const void* data, size_t size, TickType_t ticks);
+#ifdef __cplusplus
+}
+#endif
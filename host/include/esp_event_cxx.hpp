@@ -0,0 +1,20 @@
+/*
+ * esp_event_cxx.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "esp_event.h"
+
+// esp-idf-cxx ESPEventLoop on the default event loop
+namespace idf::event {
+class ESPEventLoop {
+ public:
+    ESPEventLoop() {
+        ESP_ERROR_CHECK(esp_event_loop_create_default());
+    }
+};
+} // namespace idf::event
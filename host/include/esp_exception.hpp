@@ -0,0 +1,30 @@
+/*
+ * esp_exception.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <exception>
+#include "esp_err.h"
+
+namespace idf {
+struct ESPException: public std::exception {
+    explicit ESPException(esp_err_t error)
+        : error(error) {}
+    const char* what() const noexcept override {
+        return "ESPException";
+    }
+    const esp_err_t error;
+};
+
+#define CHECK_THROW(error_)                                                                                            \
+    do {                                                                                                               \
+        const esp_err_t result_ = (error_);                                                                            \
+        if (result_ != ESP_OK) {                                                                                       \
+            throw idf::ESPException(result_);                                                                          \
+        }                                                                                                              \
+    } while (0)
+} // namespace idf
@@ -0,0 +1,22 @@
+/*
+ * esp_heap_caps.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+/*
+ * esp_mqtt.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <memory>
+#include "esp_mqtt_client_config.hpp"
+#include "mqtt_client.h"
+
+// esp-idf-cxx idf::mqtt::Client over the mqtt_client mock
+namespace idf::mqtt {
+class Client {
+ public:
+    Client(const BrokerConfiguration& broker, const ClientCredentials& credentials, const Configuration& config);
+    virtual ~Client() = default;
+
+ protected:
+    struct MqttClientDeleter {
+        void operator()(esp_mqtt_client_handle_t client) {
+            esp_mqtt_client_destroy(client);
+        }
+    };
+    std::unique_ptr<esp_mqtt_client, MqttClientDeleter> handler;
+
+    virtual void on_error(const esp_mqtt_event_handle_t) {}
+    virtual void on_disconnected(const esp_mqtt_event_handle_t) {}
+    virtual void on_connected(const esp_mqtt_event_handle_t) = 0;
+    virtual void on_published(const esp_mqtt_event_handle_t) {}
+    virtual void on_data(const esp_mqtt_event_handle_t) = 0;
+
+ private:
+    static void mqtt_event_handler(void* args, esp_event_base_t base, int32_t event_id, void* event_data);
+};
+} // namespace idf::mqtt
@@ -0,0 +1,38 @@
+/*
+ * esp_mqtt_client_config.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <variant>
+
+// the subset of the esp-idf-cxx configuration the transport uses
+namespace idf::mqtt {
+struct URI {
+    std::string address;
+};
+
+struct Insecure {};
+
+struct BrokerConfiguration {
+    std::variant<URI> address;
+    std::variant<Insecure> security;
+};
+
+struct ClientCredentials {
+    std::optional<std::string> client_id;
+};
+
+struct Connection {
+    bool disable_auto_reconnect = false;
+};
+
+struct Configuration {
+    Connection connection;
+};
+} // namespace idf::mqtt
@@ -0,0 +1,20 @@
+/*
+ * esp_netif.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_netif_ip_addr.h"
+#include "esp_netif_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+esp_err_t esp_netif_init(void);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,17 @@
+/*
+ * esp_netif_ip_addr.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t addr; // network order
+} esp_ip4_addr_t;
+
+#define ESP_IP4TOADDR(a, b, c, d)                                                                                      \
+    ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
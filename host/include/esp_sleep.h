@@ -0,0 +1,35 @@
+/*
+ * esp_sleep.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_attr.h"
+#include "esp_err.h"
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER,
+} esp_sleep_source_t;
+
+typedef esp_sleep_source_t esp_sleep_wakeup_cause_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause(void);
+// the wake process ends here, the RTC memory goes to the next one
+[[noreturn]] void esp_deep_sleep(uint64_t time_in_us);
+void              esp_default_wake_deep_sleep(void);
+// the application one, called before app_main() on the timer wakes
+void esp_wake_deep_sleep(void);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+/*
+ * esp_system.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// the process heap, see mock/system.cpp
+uint32_t    esp_get_free_heap_size(void);
+uint32_t    esp_get_minimum_free_heap_size(void);
+const char* esp_get_idf_version(void);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,56 @@
+/*
+ * esp_timer_cxx.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include "esp_exception.hpp"
+#include "esp_timer.h"
+
+// esp-idf-cxx ESPTimer over the esp_timer mock
+namespace idf::esp_timer {
+class ESPTimer {
+ public:
+    ESPTimer(std::function<void()> timeout_cb, const std::string& timer_name = "ESPTimer")
+        : timeout_cb_(timeout_cb)
+        , name_(timer_name) {
+        const esp_timer_create_args_t args = {
+            .callback              = esp_timer_cb,
+            .arg                   = this,
+            .dispatch_method       = ESP_TIMER_TASK,
+            .name                  = name_.c_str(),
+            .skip_unhandled_events = false,
+        };
+        CHECK_THROW(esp_timer_create(&args, &timer_handle_));
+    }
+    ESPTimer(const ESPTimer&)            = delete;
+    ESPTimer& operator=(const ESPTimer&) = delete;
+    ~ESPTimer() {
+        esp_timer_stop(timer_handle_);
+        esp_timer_delete(timer_handle_);
+    }
+    void start(std::chrono::microseconds timeout) {
+        CHECK_THROW(esp_timer_start_once(timer_handle_, timeout.count()));
+    }
+    void start_periodic(std::chrono::microseconds period) {
+        CHECK_THROW(esp_timer_start_periodic(timer_handle_, period.count()));
+    }
+    void stop() {
+        esp_timer_stop(timer_handle_);
+    }
+
+ private:
+    static void esp_timer_cb(void* arg) {
+        static_cast<ESPTimer*>(arg)->timeout_cb_();
+    }
+    std::function<void()> timeout_cb_;
+    std::string           name_;
+    esp_timer_handle_t    timer_handle_ = nullptr;
+};
+} // namespace idf::esp_timer
@@ -0,0 +1,20 @@
+/*
+ * esp_wifi.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_event.h"
+#include "esp_wifi_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+esp_err_t esp_wifi_sta_get_rssi(int* rssi);
+#ifdef __cplusplus
+}
+#endif
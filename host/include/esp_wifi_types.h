@@ -0,0 +1,27 @@
+/*
+ * esp_wifi_types.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "esp_event_base.h"
+
+typedef enum {
+    WIFI_EVENT_WIFI_READY,
+    WIFI_EVENT_SCAN_DONE,
+    WIFI_EVENT_STA_START,
+    WIFI_EVENT_STA_STOP,
+    WIFI_EVENT_STA_CONNECTED,
+    WIFI_EVENT_STA_DISCONNECTED,
+} wifi_event_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+ESP_EVENT_DECLARE_BASE(WIFI_EVENT);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+/*
+ * event_groups.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct EventGroupDef_t* EventGroupHandle_t;
+typedef TickType_t              EventBits_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+EventGroupHandle_t xEventGroupCreate(void);
+void               vEventGroupDelete(EventGroupHandle_t group);
+EventBits_t        xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t        xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t        xEventGroupGetBits(EventGroupHandle_t group);
+EventBits_t        xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clear_on_exit,
+           BaseType_t wait_for_all, TickType_t ticks);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,30 @@
+/*
+ * task.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// a thread, the stack size and the priority are ignored
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* arg, UBaseType_t priority,
+    TaskHandle_t* handle);
+// nullptr - the caller, returns when the task function returns
+void       vTaskDelete(TaskHandle_t task);
+void       vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+// the host has no stack high-water marks, the tasks are not looked up
+TaskHandle_t xTaskGetHandle(const char* name);
+UBaseType_t  uxTaskGetStackHighWaterMark(TaskHandle_t task);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,36 @@
+/*
+ * i2c_bus.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "driver/i2c.h"
+#include "esp_err.h"
+
+typedef void* i2c_bus_handle_t;
+typedef void* i2c_bus_device_handle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * the transfers are serialized on the bus and take the time of their bits at the simulated clock,
+ * the devices are the register models of mock/i2c_bus.cpp
+ */
+i2c_bus_handle_t        i2c_bus_create(i2c_port_t port, const i2c_config_t* conf);
+esp_err_t               i2c_bus_delete(i2c_bus_handle_t* p_bus_handle);
+i2c_bus_device_handle_t i2c_bus_device_create(i2c_bus_handle_t bus_handle, uint8_t dev_addr, uint32_t clk_speed);
+esp_err_t               i2c_bus_device_delete(i2c_bus_device_handle_t* p_dev_handle);
+esp_err_t i2c_bus_read_bytes(i2c_bus_device_handle_t dev_handle, uint8_t mem_address, size_t data_len, uint8_t* data);
+esp_err_t i2c_bus_read_byte(i2c_bus_device_handle_t dev_handle, uint8_t mem_address, uint8_t* data);
+esp_err_t i2c_bus_write_bytes(
+    i2c_bus_device_handle_t dev_handle, uint8_t mem_address, size_t data_len, const uint8_t* data);
+esp_err_t i2c_bus_write_byte(i2c_bus_device_handle_t dev_handle, uint8_t mem_address, uint8_t data);
+#ifdef __cplusplus
+}
+#endif
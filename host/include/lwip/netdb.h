@@ -0,0 +1,10 @@
+/*
+ * netdb.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <netdb.h>
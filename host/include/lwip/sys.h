@@ -0,0 +1,8 @@
+/*
+ * sys.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
@@ -0,0 +1,58 @@
+/*
+ * mqtt_client.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_event_base.h"
+
+typedef struct esp_mqtt_client* esp_mqtt_client_handle_t;
+
+typedef enum {
+    MQTT_EVENT_ANY = -1,
+    MQTT_EVENT_ERROR,
+    MQTT_EVENT_CONNECTED,
+    MQTT_EVENT_DISCONNECTED,
+    MQTT_EVENT_SUBSCRIBED,
+    MQTT_EVENT_UNSUBSCRIBED,
+    MQTT_EVENT_PUBLISHED,
+    MQTT_EVENT_DATA,
+} esp_mqtt_event_id_t;
+
+typedef struct esp_mqtt_event_t {
+    esp_mqtt_event_id_t      event_id;
+    esp_mqtt_client_handle_t client;
+    int                      msg_id;
+} esp_mqtt_event_t;
+
+typedef esp_mqtt_event_t* esp_mqtt_event_handle_t;
+
+typedef struct {
+    const char* uri;
+    bool        disable_auto_reconnect;
+} esp_mqtt_client_config_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * MQTT 3.1.1 over a TCP socket, CONNECT and QoS 0/1 PUBLISH only.
+ * the events are delivered on the "mqtt_task" thread with the client lock held, as esp-mqtt does
+ */
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t* config);
+esp_err_t                esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t event,
+                   esp_event_handler_t event_handler, void* event_handler_arg);
+esp_err_t                esp_mqtt_client_start(esp_mqtt_client_handle_t client);
+// msg_id, 0 for QoS 0, -1 when not connected
+int esp_mqtt_client_publish(
+    esp_mqtt_client_handle_t client, const char* topic, const char* data, int len, int qos, int retain);
+// stops the task, a second call on the same client does nothing
+esp_err_t esp_mqtt_client_destroy(esp_mqtt_client_handle_t client);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+/*
+ * newlib_compat.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+// newlib extensions glibc got late, included into every host translation unit
+#include <string.h>
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+#ifdef __cplusplus
+extern "C" {
+#endif
+size_t strlcpy(char* dst, const char* src, size_t size);
+#ifdef __cplusplus
+}
+#endif
+#endif
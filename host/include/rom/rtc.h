@@ -0,0 +1,8 @@
+/*
+ * rtc.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
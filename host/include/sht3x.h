@@ -0,0 +1,33 @@
+/*
+ * sht3x.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "i2c_bus.h"
+
+#define SHT3x_ADDR_PIN_SELECT_VSS 0x44
+#define SHT3x_ADDR_PIN_SELECT_VDD 0x45
+
+typedef void* sht3x_handle_t;
+
+typedef enum {
+    SHT3x_PER_2_HIGH = 0x2236,
+} sht3x_cmd_measure_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// modelled at the driver level, see mock/i2c_bus.cpp
+sht3x_handle_t sht3x_create(i2c_bus_handle_t bus, uint8_t dev_addr);
+esp_err_t      sht3x_delete(sht3x_handle_t* sensor);
+esp_err_t      sht3x_set_measure_mode(sht3x_handle_t sensor, sht3x_cmd_measure_t sht3x_measure_mode);
+esp_err_t      sht3x_get_humiture(sht3x_handle_t sensor, float* Tem_val, float* Hum_val);
+esp_err_t      sht3x_soft_reset(sht3x_handle_t sensor);
+#ifdef __cplusplus
+}
+#endif
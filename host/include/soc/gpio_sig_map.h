@@ -0,0 +1,10 @@
+/*
+ * gpio_sig_map.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+// only the wake stub needs it, CONFIG_WAKE_STUB_PRESCREEN is off on the host
@@ -0,0 +1,200 @@
+/*
+ * json_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+#include <string>
+#include "cJSON.h"
+#include "cycles.hpp"
+#include "json_helper.hpp"
+
+/*
+ * json::Writer against the cJSON helpers it replaced (CreateObject, AddFormatedToObject, PrintUnformatted):
+ * the same sensors message of a batch of samples, the output byte identical, the cycles and the heap
+ * allocations per message. the allocations are counted by the cJSON hooks and operator new.
+ * json_bench [--iterations 10000] [--samples 4]
+ */
+static std::atomic<long> allocations;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* res = malloc(size)) {
+        return res;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+    free(ptr);
+}
+
+static void* counted_malloc(size_t size) {
+    allocations++;
+    return malloc(size);
+}
+
+typedef struct {
+    uint32_t boot;
+    uint32_t time;
+    float    temperature;
+    float    humidity;
+    float    pressure;
+    float    battery;
+} sample_t;
+
+static sample_t sample(int i) {
+    return { static_cast<uint32_t>(1000 + i), static_cast<uint32_t>(1792195200 + 60 * i), 21.37f + i * 0.01f,
+        53.4f - i * 0.1f, 1018.42f + i * 0.02f, 3.912f };
+}
+
+// the previous helpers of main/json_helper.hpp
+namespace legacy {
+class CreateObject {
+ private:
+    cJSON* item;
+
+ public:
+    CreateObject()
+        : item(cJSON_CreateObject()) {}
+    auto get() const {
+        return item;
+    }
+    ~CreateObject() {
+        cJSON_Delete(item);
+    }
+};
+
+inline std::string PrintUnformatted(const CreateObject& obj) {
+    const auto  my_json = cJSON_PrintUnformatted(obj.get());
+    std::string res(my_json);
+    cJSON_free(my_json);
+    return res;
+}
+
+template<typename T>
+void AddFormatedToObject(cJSON* const obj, const char* const name, const char* format, T var) {
+    char       tt[255];
+    const auto cnt = snprintf(tt, sizeof(tt) - 1, format, var);
+    tt[cnt]        = 0;
+    cJSON_AddRawToObject(obj, name, tt);
+}
+
+static void add_sensors(cJSON* obj, const sample_t& val) {
+    AddFormatedToObject(obj, "temperature", "%.2f", val.temperature);
+    AddFormatedToObject(obj, "humidity", "%.2f", val.humidity);
+    AddFormatedToObject(obj, "pressure", "%.2f", val.pressure);
+    AddFormatedToObject(obj, "battery", "%.3f", val.battery);
+}
+
+static std::string sensors(int samples) {
+    CreateObject root;
+    const auto   latest = sample(samples - 1);
+    cJSON_AddStringToObject(root.get(), "mac", "A0B1C2D3E4F5");
+    cJSON_AddNumberToObject(root.get(), "time", latest.time);
+    add_sensors(root.get(), latest);
+    if (samples > 1) {
+        auto* array = cJSON_AddArrayToObject(root.get(), "samples");
+        for (int i = 0; i < samples; i++) {
+            const auto val  = sample(i);
+            auto*      item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "boot", val.boot);
+            cJSON_AddNumberToObject(item, "time", val.time);
+            add_sensors(item, val);
+            cJSON_AddItemToArray(array, item);
+        }
+    }
+    auto* link = cJSON_AddObjectToObject(root.get(), "link");
+    cJSON_AddNumberToObject(link, "rssi", -67);
+    cJSON_AddNumberToObject(link, "fast_connect_hits", 1234);
+    cJSON_AddNumberToObject(link, "fast_connect_misses", 5);
+    return PrintUnformatted(root);
+}
+} // namespace legacy
+
+namespace writer {
+static char json_buf[768 + 192 * 16];
+
+static void add_sensors(json::Writer& out, const sample_t& val) {
+    out.add_formated("temperature", "%.2f", val.temperature);
+    out.add_formated("humidity", "%.2f", val.humidity);
+    out.add_formated("pressure", "%.2f", val.pressure);
+    out.add_formated("battery", "%.3f", val.battery);
+}
+
+// as main/payload.cpp, the message is copied to the std::string of the outbox
+static std::string sensors(int samples) {
+    json::Writer out(json_buf, sizeof(json_buf));
+    const auto   latest = sample(samples - 1);
+    out.begin_object().add("mac", "A0B1C2D3E4F5").add("time", latest.time);
+    add_sensors(out, latest);
+    if (samples > 1) {
+        out.begin_array("samples");
+        for (int i = 0; i < samples; i++) {
+            const auto val = sample(i);
+            out.begin_object().add("boot", val.boot).add("time", val.time);
+            add_sensors(out, val);
+            out.end_object();
+        }
+        out.end_array();
+    }
+    out.begin_object("link")
+        .add("rssi", -67)
+        .add("fast_connect_hits", 1234)
+        .add("fast_connect_misses", 5)
+        .end_object();
+    out.end_object();
+    return out.ok() ? std::string(out.c_str(), out.size()) : std::string();
+}
+} // namespace writer
+
+static void run(const char* name, std::string (*build)(int), int samples, int iterations) {
+    const long     allocated = allocations;
+    const uint64_t start     = cycles();
+    size_t         bytes     = 0;
+    for (int i = 0; i < iterations; i++) {
+        bytes += build(samples).size();
+    }
+    const uint64_t spent = cycles() - start;
+    printf("%-8s %8.0f cycles/msg %6.1f allocations/msg %zu bytes\n", name, double(spent) / iterations,
+        double(allocations - allocated) / iterations, bytes / iterations);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = 10000;
+    int samples    = 4;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string arg = argv[i];
+        if (arg == "--iterations") {
+            iterations = atoi(argv[i + 1]);
+        } else if (arg == "--samples") {
+            samples = atoi(argv[i + 1]);
+        }
+    }
+    if (iterations <= 0 || samples <= 0 || samples > 16) {
+        fputs("json_bench [--iterations 10000] [--samples 4], 1..16 samples\n", stderr);
+        return 2;
+    }
+    cJSON_Hooks hooks = { counted_malloc, free };
+    cJSON_InitHooks(&hooks);
+
+    const auto expected = legacy::sensors(samples);
+    const auto got      = writer::sensors(samples);
+    if (got != expected) {
+        printf("output differs\ncJSON:  %s\nWriter: %s\n", expected.c_str(), got.c_str());
+        return 1;
+    }
+    printf("%d samples, %zu bytes, identical output\n", samples, got.size());
+    run("cJSON", legacy::sensors, samples, iterations);
+    run("Writer", writer::sensors, samples, iterations);
+    return 0;
+}
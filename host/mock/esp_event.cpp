@@ -0,0 +1,83 @@
+/*
+ * esp_event.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "esp_event.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+// the default loop, the "sys_evt" task calls the handlers in the order of the posts
+typedef struct {
+    esp_event_base_t    base;
+    int32_t             id;
+    esp_event_handler_t handler;
+    void*               arg;
+} handler_t;
+
+typedef struct {
+    esp_event_base_t  base;
+    int32_t           id;
+    std::vector<char> data;
+} event_t;
+
+static std::mutex              mutex;
+static std::condition_variable posted;
+static std::vector<handler_t>  handlers;
+static std::deque<event_t>     events;
+static bool                    created = false;
+
+static void dispatch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        posted.wait(lock, []() { return !events.empty(); });
+        auto event = std::move(events.front());
+        events.pop_front();
+        const auto current = handlers;
+        lock.unlock();
+        for (const auto& handler : current) {
+            if (handler.base == event.base && (handler.id == ESP_EVENT_ANY_ID || handler.id == event.id)) {
+                handler.handler(handler.arg, event.base, event.id, event.data.empty() ? nullptr : event.data.data());
+            }
+        }
+        lock.lock();
+    }
+}
+
+esp_err_t esp_event_loop_create_default(void) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (created) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    created = true;
+    std::thread(dispatch).detach();
+    return ESP_OK;
+}
+
+esp_err_t esp_event_handler_register(esp_event_base_t base, int32_t id, esp_event_handler_t handler, void* arg) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!created) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    handlers.push_back({ base, id, handler, arg });
+    return ESP_OK;
+}
+
+esp_err_t esp_event_post(esp_event_base_t base, int32_t id, const void* data, size_t size, TickType_t /*ticks*/) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!created) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const auto* bytes = static_cast<const char*>(data);
+    events.push_back({ base, id, std::vector<char>(bytes, bytes + (data ? size : 0)) });
+    posted.notify_all();
+    return ESP_OK;
+}
@@ -0,0 +1,33 @@
+/*
+ * esp_log.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "esp_log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include "sim.hpp"
+
+void esp_log_level_set(const char* /*tag*/, esp_log_level_t level) {
+    sim::config.log_level = level;
+}
+
+uint32_t esp_log_timestamp(void) {
+    return sim::uptime_us() / 1000;
+}
+
+// a line of the device at once, the devices share stderr
+void esp_log_write(esp_log_level_t level, const char* /*tag*/, const char* format, ...) {
+    if (level > sim::config.log_level) {
+        return;
+    }
+    char    line[512];
+    int     len = snprintf(line, sizeof(line), "[%d] ", sim::config.device);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line + len, sizeof(line) - len, format, args);
+    va_end(args);
+    fputs(line, stderr);
+}
@@ -0,0 +1,120 @@
+/*
+ * esp_timer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "esp_timer.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include "sim.hpp"
+
+// the "esp_timer" task: the callbacks are called one at a time in the order of their deadlines
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void*          arg;
+    bool           active    = false;
+    int64_t        due_us    = 0; // uptime
+    int64_t        period_us = 0; // 0 - once
+};
+
+static std::mutex              mutex;
+static std::condition_variable changed;
+static std::list<esp_timer*>   timers;
+static esp_timer*              running = nullptr;
+static std::thread::id         task;
+
+static void dispatch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        const auto next = std::min_element(timers.begin(), timers.end(), [](const auto* a, const auto* b) {
+            return a->active != b->active ? a->active : a->due_us < b->due_us;
+        });
+        if (next == timers.end() || !(*next)->active) {
+            changed.wait(lock);
+            continue;
+        }
+        auto*         timer = *next;
+        const int64_t left  = timer->due_us - sim::uptime_us();
+        if (left > 0) {
+            changed.wait_for(lock, std::chrono::microseconds(sim::to_real_us(left)));
+            continue;
+        }
+        timer->active = timer->period_us != 0;
+        timer->due_us += timer->period_us;
+        running = timer;
+        lock.unlock();
+        // the timer may be deleted by its own callback
+        timer->callback(timer->arg);
+        lock.lock();
+        running = nullptr;
+        changed.notify_all();
+    }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (task == std::thread::id()) {
+        std::thread thread(dispatch);
+        task = thread.get_id();
+        thread.detach();
+    }
+    *out = new esp_timer{ .callback = args->callback, .arg = args->arg };
+    timers.push_back(*out);
+    return ESP_OK;
+}
+
+static esp_err_t start(esp_timer_handle_t timer, uint64_t timeout_us, uint64_t period_us) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->active    = true;
+    timer->due_us    = sim::uptime_us() + timeout_us;
+    timer->period_us = period_us;
+    changed.notify_all();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    return start(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+    return start(timer, period_us, period_us);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->active = false;
+    changed.notify_all();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    std::unique_lock<std::mutex> lock(mutex);
+    timer->active = false;
+    if (std::this_thread::get_id() != task) {
+        changed.wait(lock, [timer]() { return running != timer; });
+    }
+    timers.remove(timer);
+    delete timer;
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timer->active;
+}
+
+int64_t esp_timer_get_time(void) {
+    return sim::uptime_us();
+}
@@ -0,0 +1,95 @@
+/*
+ * freertos.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+#include "sim.hpp"
+
+constexpr int64_t TICK_US = portTICK_PERIOD_MS * 1000;
+
+struct EventGroupDef_t {
+    std::mutex              mutex;
+    std::condition_variable changed;
+    EventBits_t             bits = 0;
+};
+
+BaseType_t xTaskCreate(
+    TaskFunction_t fn, const char* /*name*/, uint32_t /*stack*/, void* arg, UBaseType_t /*priority*/, TaskHandle_t* handle) {
+    std::thread(fn, arg).detach();
+    if (handle) {
+        *handle = nullptr;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t /*task*/) {}
+
+void vTaskDelay(TickType_t ticks) {
+    sim::delay_us(ticks * TICK_US);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return static_cast<TickType_t>(sim::uptime_us() / TICK_US);
+}
+
+TaskHandle_t xTaskGetHandle(const char* /*name*/) {
+    return nullptr;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t /*task*/) {
+    return 0;
+}
+
+EventGroupHandle_t xEventGroupCreate(void) {
+    return new EventGroupDef_t;
+}
+
+void vEventGroupDelete(EventGroupHandle_t group) {
+    delete group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    group->bits |= bits;
+    group->changed.notify_all();
+    return group->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    const auto                  res = group->bits;
+    group->bits &= ~bits;
+    return res;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    return group->bits;
+}
+
+EventBits_t xEventGroupWaitBits(
+    EventGroupHandle_t group, EventBits_t bits, BaseType_t clear_on_exit, BaseType_t wait_for_all, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(group->mutex);
+    const auto                   set = [&]() {
+        return wait_for_all ? (group->bits & bits) == bits : (group->bits & bits) != 0;
+    };
+    if (ticks == portMAX_DELAY) {
+        group->changed.wait(lock, set);
+    } else {
+        group->changed.wait_for(lock, std::chrono::microseconds(sim::to_real_us(ticks * TICK_US)), set);
+    }
+    const auto res = group->bits;
+    if (clear_on_exit && set()) {
+        group->bits &= ~bits;
+    }
+    return res;
+}
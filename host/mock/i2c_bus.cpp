@@ -0,0 +1,321 @@
+/*
+ * i2c_bus.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "i2c_bus.h"
+#include <math.h>
+#include <string.h>
+#include <mutex>
+#include "bh1750.h"
+#include "bme280.h"
+#include "bme280_compensate.hpp"
+#include "sht3x.h"
+#include "sim.hpp"
+
+/*
+ * the sensors on the bus. the BME280 is a register model driven by the application through i2c_bus,
+ * SHT3x and BH1750 are modelled at their driver API. all of them measure the same environment
+ */
+namespace {
+constexpr double  DAY_S        = 86400;
+constexpr int64_t SHT3X_READY  = 15500;  // us, high repeatability
+constexpr int64_t BH1750_READY = 120000; // us, typical of the high resolution mode
+
+typedef struct {
+    double temperature; // C
+    double pressure;    // hPa
+    double humidity;    // %RH
+    double light;       // lux
+} environment_t;
+
+// the sensors stay powered through the deep sleep of the MCU, the state goes with the flash
+typedef struct {
+    bool    initialized;
+    uint8_t regs[256];
+    int64_t done_us; // true time the conversion completes, 0 - idle
+    int64_t sht3x_ready_us;
+    int64_t bh1750_ready_us;
+} board_t;
+
+SIM_HW_ATTR board_t           board;
+std::mutex                    bus;
+std::recursive_mutex          state;
+const sensors::bme280_calib_t CALIB = {
+    .dig_T1 = 27504,
+    .dig_T2 = 26435,
+    .dig_T3 = -1000,
+    .dig_P1 = 36477,
+    .dig_P2 = -10685,
+    .dig_P3 = 3024,
+    .dig_P4 = 2855,
+    .dig_P5 = 140,
+    .dig_P6 = -7,
+    .dig_P7 = 15500,
+    .dig_P8 = -14600,
+    .dig_P9 = 6000,
+    .dig_H1 = 75,
+    .dig_H2 = 362,
+    .dig_H3 = 0,
+    .dig_H4 = 313,
+    .dig_H5 = 50,
+    .dig_H6 = 30,
+};
+
+typedef struct {
+    uint8_t address;
+} device_t;
+
+// a daily cycle, the pressure over three days, a little noise on top
+environment_t environment() {
+    const double t = sim::true_time_us() / 1e6;
+    return {
+        .temperature = 21 + 3 * sin(2 * M_PI * t / DAY_S) + sim::noise(10) / 1000.,
+        .pressure    = 1013.25 + 6 * sin(2 * M_PI * t / (3 * DAY_S)) + sim::noise(10) / 1000.,
+        .humidity    = 45 + 10 * sin(2 * M_PI * t / DAY_S + 1) + sim::noise(10) / 1000.,
+        .light       = std::max(0., 500 * sin(2 * M_PI * t / DAY_S)),
+    };
+}
+
+void put16(uint8_t* regs, int16_t val) {
+    regs[0] = val & 0xff;
+    regs[1] = (val >> 8) & 0xff;
+}
+
+void power_on() {
+    if (board.initialized) {
+        return;
+    }
+    board.initialized                 = true;
+    auto* regs                        = board.regs;
+    regs[sensors::BME280_REG_CHIP_ID] = sensors::BME280_CHIP_ID;
+    const int16_t tp[]                = { static_cast<int16_t>(CALIB.dig_T1), CALIB.dig_T2, CALIB.dig_T3,
+        static_cast<int16_t>(CALIB.dig_P1), CALIB.dig_P2, CALIB.dig_P3, CALIB.dig_P4, CALIB.dig_P5, CALIB.dig_P6,
+        CALIB.dig_P7, CALIB.dig_P8, CALIB.dig_P9 };
+    for (size_t i = 0; i < std::size(tp); i++) {
+        put16(regs + sensors::BME280_REG_CALIB_TP + 2 * i, tp[i]);
+    }
+    regs[0xA1] = CALIB.dig_H1;
+    put16(regs + 0xE1, CALIB.dig_H2);
+    regs[0xE3] = CALIB.dig_H3;
+    regs[0xE4] = CALIB.dig_H4 >> 4;
+    regs[0xE5] = (CALIB.dig_H4 & 0x0f) | ((CALIB.dig_H5 & 0x0f) << 4);
+    regs[0xE6] = CALIB.dig_H5 >> 4;
+    regs[0xE7] = CALIB.dig_H6;
+    // the reset values of the data registers
+    regs[0xF7] = 0x80;
+    regs[0xFA] = 0x80;
+    regs[0xFD] = 0x80;
+}
+
+// the raw value the compensation turns into the target, the compensation is monotonic in each of them
+template<typename F>
+int32_t invert(int32_t lo, int32_t hi, double target, F&& value) {
+    const bool rising = value(hi) > value(lo);
+    while (hi - lo > 1) {
+        const int32_t mid = lo + (hi - lo) / 2;
+        ((value(mid) < target) == rising ? lo : hi) = mid;
+    }
+    return lo;
+}
+
+unsigned oversampling(unsigned osrs) {
+    return osrs ? 1u << (osrs - 1) : 0;
+}
+
+void convert() {
+    auto*         regs = board.regs;
+    const auto    env  = environment();
+    const uint8_t meas = regs[sensors::BME280_REG_CTRL_MEAS];
+    const uint8_t hum  = regs[sensors::BME280_REG_CTRL_HUM] & 0x07;
+
+    sensors::bme280_raw_t raw = { 0, 0, 0 };
+    raw.temperature = invert(0, 1 << 20, env.temperature, [&](int32_t val) {
+        return sensors::bme280_compensate(CALIB, { val, 0, 0 }).temperature;
+    });
+    raw.pressure = invert(0, 1 << 20, env.pressure, [&](int32_t val) {
+        return sensors::bme280_compensate(CALIB, { raw.temperature, val, 0 }).pressure;
+    });
+    raw.humidity = invert(0, 1 << 16, env.humidity, [&](int32_t val) {
+        return sensors::bme280_compensate(CALIB, { raw.temperature, 0, val }).humidity;
+    });
+    if (!(meas >> 5)) {
+        raw.temperature = sensors::BME280_ADC_SKIPPED;
+    }
+    if (!((meas >> 2) & 0x07)) {
+        raw.pressure = sensors::BME280_ADC_SKIPPED;
+    }
+    if (!hum) {
+        raw.humidity = 0x8000;
+    }
+    regs[0xF7] = raw.pressure >> 12;
+    regs[0xF8] = raw.pressure >> 4;
+    regs[0xF9] = (raw.pressure & 0x0f) << 4;
+    regs[0xFA] = raw.temperature >> 12;
+    regs[0xFB] = raw.temperature >> 4;
+    regs[0xFC] = (raw.temperature & 0x0f) << 4;
+    regs[0xFD] = raw.humidity >> 8;
+    regs[0xFE] = raw.humidity & 0xff;
+}
+
+// the forced mode conversion completes, the sensor goes back to sleep
+void update() {
+    if (board.done_us && sim::true_time_us() >= board.done_us) {
+        board.done_us = 0;
+        convert();
+        board.regs[sensors::BME280_REG_STATUS] &= ~sensors::BME280_STATUS_MEASURING;
+        board.regs[sensors::BME280_REG_CTRL_MEAS] &= ~0x03;
+    }
+}
+
+// datasheet 9.1, typical
+int64_t conversion_us() {
+    const uint8_t meas = board.regs[sensors::BME280_REG_CTRL_MEAS];
+    const auto    t    = oversampling(meas >> 5);
+    const auto    p    = oversampling((meas >> 2) & 0x07);
+    const auto    h    = oversampling(board.regs[sensors::BME280_REG_CTRL_HUM] & 0x07);
+    return 1000 + 2000 * t + (p ? 2000 * p + 500 : 0) + (h ? 2000 * h + 500 : 0);
+}
+
+void write(uint8_t reg, uint8_t val) {
+    board.regs[reg] = val;
+    if (reg == sensors::BME280_REG_CTRL_MEAS && (val & 0x03) && (val & 0x03) != BME280_MODE_NORMAL) {
+        board.regs[sensors::BME280_REG_STATUS] |= sensors::BME280_STATUS_MEASURING;
+        board.done_us = sim::true_time_us() + conversion_us();
+    }
+}
+
+// address, register, repeated start with the address, the data: 9 bits each
+esp_err_t transfer(const device_t* dev, size_t len) {
+    std::lock_guard<std::mutex> lock(bus);
+    sim::delay_us((len + 3) * 9 * 1000 / sim::config.i2c_khz);
+    return dev->address == BME280_I2C_ADDRESS_DEFAULT ? ESP_OK : ESP_FAIL;
+}
+} // namespace
+
+i2c_bus_handle_t i2c_bus_create(i2c_port_t /*port*/, const i2c_config_t* /*conf*/) {
+    std::lock_guard<std::recursive_mutex> lock(state);
+    power_on();
+    return &board;
+}
+
+esp_err_t i2c_bus_delete(i2c_bus_handle_t* p_bus_handle) {
+    *p_bus_handle = nullptr;
+    return ESP_OK;
+}
+
+i2c_bus_device_handle_t i2c_bus_device_create(i2c_bus_handle_t /*bus_handle*/, uint8_t dev_addr, uint32_t /*clk*/) {
+    return new device_t{ dev_addr };
+}
+
+esp_err_t i2c_bus_device_delete(i2c_bus_device_handle_t* p_dev_handle) {
+    delete static_cast<device_t*>(*p_dev_handle);
+    *p_dev_handle = nullptr;
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_read_bytes(i2c_bus_device_handle_t dev_handle, uint8_t mem_address, size_t data_len, uint8_t* data) {
+    const auto res = transfer(static_cast<device_t*>(dev_handle), data_len);
+    if (res == ESP_OK) {
+        std::lock_guard<std::recursive_mutex> lock(state);
+        update();
+        for (size_t i = 0; i < data_len; i++) {
+            data[i] = board.regs[(mem_address + i) & 0xff];
+        }
+    }
+    return res;
+}
+
+esp_err_t i2c_bus_read_byte(i2c_bus_device_handle_t dev_handle, uint8_t mem_address, uint8_t* data) {
+    return i2c_bus_read_bytes(dev_handle, mem_address, 1, data);
+}
+
+esp_err_t i2c_bus_write_bytes(
+    i2c_bus_device_handle_t dev_handle, uint8_t mem_address, size_t data_len, const uint8_t* data) {
+    // no repeated start
+    const auto res = transfer(static_cast<device_t*>(dev_handle), data_len - 1);
+    if (res == ESP_OK) {
+        std::lock_guard<std::recursive_mutex> lock(state);
+        update();
+        for (size_t i = 0; i < data_len; i++) {
+            write((mem_address + i) & 0xff, data[i]);
+        }
+    }
+    return res;
+}
+
+esp_err_t i2c_bus_write_byte(i2c_bus_device_handle_t dev_handle, uint8_t mem_address, uint8_t data) {
+    return i2c_bus_write_bytes(dev_handle, mem_address, 1, &data);
+}
+
+sht3x_handle_t sht3x_create(i2c_bus_handle_t /*bus*/, uint8_t /*dev_addr*/) {
+    return &board;
+}
+
+esp_err_t sht3x_delete(sht3x_handle_t* sensor) {
+    *sensor = nullptr;
+    return ESP_OK;
+}
+
+esp_err_t sht3x_set_measure_mode(sht3x_handle_t /*sensor*/, sht3x_cmd_measure_t /*sht3x_measure_mode*/) {
+    const device_t dev = { SHT3x_ADDR_PIN_SELECT_VSS };
+    transfer(&dev, 0);
+    std::lock_guard<std::recursive_mutex> lock(state);
+    board.sht3x_ready_us = sim::true_time_us() + SHT3X_READY;
+    return ESP_OK;
+}
+
+// NACK until the first sample of the periodic mode
+esp_err_t sht3x_get_humiture(sht3x_handle_t /*sensor*/, float* Tem_val, float* Hum_val) {
+    const device_t dev = { SHT3x_ADDR_PIN_SELECT_VSS };
+    transfer(&dev, 4);
+    std::lock_guard<std::recursive_mutex> lock(state);
+    if (!board.sht3x_ready_us || sim::true_time_us() < board.sht3x_ready_us) {
+        return ESP_FAIL;
+    }
+    const auto env = environment();
+    *Tem_val       = env.temperature + 0.1;
+    *Hum_val       = env.humidity - 0.5;
+    return ESP_OK;
+}
+
+esp_err_t sht3x_soft_reset(sht3x_handle_t /*sensor*/) {
+    std::lock_guard<std::recursive_mutex> lock(state);
+    board.sht3x_ready_us = 0;
+    return ESP_OK;
+}
+
+bh1750_handle_t bh1750_create(i2c_bus_handle_t /*port*/, const uint8_t /*dev_addr*/) {
+    return &board;
+}
+
+esp_err_t bh1750_delete(bh1750_handle_t* sensor) {
+    *sensor = nullptr;
+    return ESP_OK;
+}
+
+esp_err_t bh1750_power_on(bh1750_handle_t /*sensor*/) {
+    return ESP_OK;
+}
+
+esp_err_t bh1750_power_down(bh1750_handle_t /*sensor*/) {
+    std::lock_guard<std::recursive_mutex> lock(state);
+    board.bh1750_ready_us = 0;
+    return ESP_OK;
+}
+
+esp_err_t bh1750_set_measure_mode(bh1750_handle_t /*sensor*/, const bh1750_measure_mode_t /*cmd_measure*/) {
+    std::lock_guard<std::recursive_mutex> lock(state);
+    board.bh1750_ready_us = sim::true_time_us() + BH1750_READY;
+    return ESP_OK;
+}
+
+// the one time mode reads 0 until converted
+esp_err_t bh1750_get_data(bh1750_handle_t /*sensor*/, float* const data) {
+    std::lock_guard<std::recursive_mutex> lock(state);
+    const bool ready = board.bh1750_ready_us && sim::true_time_us() >= board.bh1750_ready_us;
+    *data            = ready ? environment().light : 0;
+    return ESP_OK;
+}
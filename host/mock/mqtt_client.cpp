@@ -0,0 +1,286 @@
+/*
+ * mqtt_client.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "mqtt_client.h"
+#include <netdb.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "esp_log.h"
+#include "esp_mac.h"
+#include "esp_mqtt.hpp"
+#include "sim.hpp"
+
+static const char* TAG = "SIM_MQTT";
+
+constexpr uint8_t CONNECT    = 0x10;
+constexpr uint8_t CONNACK    = 0x20;
+constexpr uint8_t PUBLISH    = 0x30;
+constexpr uint8_t PUBACK     = 0x40;
+constexpr uint8_t DISCONNECT = 0xE0;
+constexpr int     KEEPALIVE  = 120;
+
+struct esp_mqtt_client {
+    std::string          uri;
+    esp_event_handler_t  handler     = nullptr;
+    void*                handler_arg = nullptr;
+    std::recursive_mutex api_lock; // held by the events and the API calls, as in esp-mqtt
+    std::thread          task;
+    int                  sock      = -1;
+    bool                 connected = false;
+    bool                 destroyed = false;
+    uint16_t             msg_id    = 0;
+};
+
+static void put_length(std::vector<uint8_t>& out, size_t len) {
+    do {
+        uint8_t byte = len % 128;
+        len /= 128;
+        out.push_back(len ? byte | 0x80 : byte);
+    } while (len);
+}
+
+static void put_string(std::vector<uint8_t>& out, const std::string& str) {
+    out.push_back(str.size() >> 8);
+    out.push_back(str.size() & 0xff);
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+static std::vector<uint8_t> packet(uint8_t header, const std::vector<uint8_t>& body) {
+    std::vector<uint8_t> res = { header };
+    put_length(res, body.size());
+    res.insert(res.end(), body.begin(), body.end());
+    return res;
+}
+
+static bool send_all(esp_mqtt_client_handle_t client, const std::vector<uint8_t>& data) {
+    for (size_t sent = 0; sent < data.size();) {
+        const auto len = send(client->sock, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (len <= 0) {
+            return false;
+        }
+        sent += len;
+    }
+    sim::count_sent(data.size());
+    return true;
+}
+
+static bool recv_all(int sock, uint8_t* data, size_t size) {
+    for (size_t got = 0; got < size;) {
+        const auto len = recv(sock, data + got, size - got, 0);
+        if (len <= 0) {
+            return false;
+        }
+        got += len;
+    }
+    sim::count_received(size);
+    return true;
+}
+
+// mqtt://host:port of CONFIG_BROKER_URL, the simulation may point it elsewhere
+static int open_socket(const std::string& uri) {
+    std::string address = sim::config.broker;
+    if (address.empty()) {
+        const auto scheme = uri.find("://");
+        address           = scheme == std::string::npos ? uri : uri.substr(scheme + 3);
+    }
+    const auto colon = address.rfind(':');
+    const auto host  = address.substr(0, colon);
+    const auto port  = colon == std::string::npos ? std::string("1883") : address.substr(colon + 1);
+    addrinfo   hints  = {};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res     = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0 || !res) {
+        return -1;
+    }
+    int sock = socket(res->ai_family, res->ai_socktype, 0);
+    if (sock >= 0 && connect(sock, res->ai_addr, res->ai_addrlen) != 0) {
+        close(sock);
+        sock = -1;
+    }
+    freeaddrinfo(res);
+    return sock;
+}
+
+static void dispatch(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t id, int msg_id) {
+    std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+    if (client->destroyed) {
+        return;
+    }
+    esp_mqtt_event_t event = { .event_id = id, .client = client, .msg_id = msg_id };
+    client->handler(client->handler_arg, "MQTT_EVENTS", id, &event);
+}
+
+// the "mqtt_task"
+static void run(esp_mqtt_client_handle_t client) {
+    sim::delay_us(sim::config.connect_us);
+    client->sock = open_socket(client->uri);
+    if (client->sock < 0) {
+        ESP_LOGE(TAG, "no broker at %s", sim::config.broker.empty() ? client->uri.c_str() : sim::config.broker.c_str());
+        dispatch(client, MQTT_EVENT_ERROR, 0);
+        dispatch(client, MQTT_EVENT_DISCONNECTED, 0);
+        return;
+    }
+    uint8_t mac[6];
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    char client_id[32];
+    snprintf(client_id, sizeof(client_id), "ESP32_%02X%02X%02X", mac[3], mac[4], mac[5]);
+    std::vector<uint8_t> body;
+    put_string(body, "MQTT");
+    body.insert(body.end(), { 4, 0x02, KEEPALIVE >> 8, KEEPALIVE & 0xff }); // 3.1.1, clean session
+    put_string(body, client_id);
+    {
+        std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+        send_all(client, packet(CONNECT, body));
+    }
+    for (;;) {
+        uint8_t header;
+        if (!recv_all(client->sock, &header, 1)) {
+            break;
+        }
+        size_t  len   = 0;
+        int     shift = 0;
+        uint8_t byte;
+        do {
+            if (!recv_all(client->sock, &byte, 1)) {
+                byte = 0;
+                len  = SIZE_MAX;
+                break;
+            }
+            len |= static_cast<size_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        std::vector<uint8_t> data(len == SIZE_MAX ? 0 : len);
+        if (len == SIZE_MAX || !recv_all(client->sock, data.data(), data.size())) {
+            break;
+        }
+        if ((header & 0xf0) == CONNACK && data.size() >= 2) {
+            if (data[1]) {
+                ESP_LOGE(TAG, "connection refused %d", data[1]);
+                break;
+            }
+            {
+                std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+                client->connected = true;
+            }
+            dispatch(client, MQTT_EVENT_CONNECTED, 0);
+        } else if ((header & 0xf0) == PUBACK && data.size() >= 2) {
+            dispatch(client, MQTT_EVENT_PUBLISHED, (data[0] << 8) | data[1]);
+        }
+    }
+    {
+        std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+        client->connected = false;
+    }
+    dispatch(client, MQTT_EVENT_DISCONNECTED, 0);
+}
+
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t* config) {
+    auto* client = new esp_mqtt_client;
+    client->uri  = config->uri ? config->uri : "";
+    return client;
+}
+
+esp_err_t esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t /*event*/,
+    esp_event_handler_t event_handler, void* event_handler_arg) {
+    std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+    client->handler     = event_handler;
+    client->handler_arg = event_handler_arg;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_start(esp_mqtt_client_handle_t client) {
+    client->task = std::thread(run, client);
+    return ESP_OK;
+}
+
+int esp_mqtt_client_publish(
+    esp_mqtt_client_handle_t client, const char* topic, const char* data, int len, int qos, int retain) {
+    std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+    if (!client->connected) {
+        return -1;
+    }
+    std::vector<uint8_t> body;
+    put_string(body, topic);
+    int msg_id = 0;
+    if (qos) {
+        msg_id = client->msg_id = client->msg_id % 0xffff + 1;
+        body.push_back(msg_id >> 8);
+        body.push_back(msg_id & 0xff);
+    }
+    body.insert(body.end(), data, data + (len ? len : strlen(data)));
+    return send_all(client, packet(PUBLISH | (qos << 1) | (retain ? 1 : 0), body)) ? msg_id : -1;
+}
+
+// the memory is not released, the wake process ends soon
+esp_err_t esp_mqtt_client_destroy(esp_mqtt_client_handle_t client) {
+    if (!client) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::recursive_mutex> lock(client->api_lock);
+        if (client->destroyed) {
+            return ESP_OK;
+        }
+        client->destroyed = true;
+        if (client->connected) {
+            send_all(client, { DISCONNECT, 0 });
+        }
+        if (client->sock >= 0) {
+            shutdown(client->sock, SHUT_RDWR);
+        }
+    }
+    if (client->task.joinable()) {
+        if (client->task.get_id() == std::this_thread::get_id()) {
+            client->task.detach();
+        } else {
+            client->task.join();
+        }
+    }
+    return ESP_OK;
+}
+
+namespace idf::mqtt {
+Client::Client(const BrokerConfiguration& broker, const ClientCredentials& /*credentials*/, const Configuration& config)
+    : handler(nullptr) {
+    const auto                     uri = std::get<URI>(broker.address).address;
+    const esp_mqtt_client_config_t cfg = {
+        .uri                    = uri.c_str(),
+        .disable_auto_reconnect = config.connection.disable_auto_reconnect,
+    };
+    handler.reset(esp_mqtt_client_init(&cfg));
+    esp_mqtt_client_register_event(handler.get(), MQTT_EVENT_ANY, mqtt_event_handler, this);
+    esp_mqtt_client_start(handler.get());
+}
+
+void Client::mqtt_event_handler(void* args, esp_event_base_t /*base*/, int32_t event_id, void* event_data) {
+    auto* self  = static_cast<Client*>(args);
+    auto* event = static_cast<esp_mqtt_event_handle_t>(event_data);
+    switch (event_id) {
+        case MQTT_EVENT_CONNECTED:
+            self->on_connected(event);
+            break;
+        case MQTT_EVENT_DISCONNECTED:
+            self->on_disconnected(event);
+            break;
+        case MQTT_EVENT_PUBLISHED:
+            self->on_published(event);
+            break;
+        case MQTT_EVENT_ERROR:
+            self->on_error(event);
+            break;
+        default:
+            break;
+    }
+}
+} // namespace idf::mqtt
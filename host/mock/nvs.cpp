@@ -0,0 +1,173 @@
+/*
+ * nvs.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include "nvs_flash.h"
+#include "sim.hpp"
+
+constexpr size_t ENTRIES   = 64;
+constexpr size_t BLOB_SIZE = 1024;
+
+// the flash of the device, a fixed table carried over the wakes by sim::deep_sleep()
+typedef struct {
+    bool   used;
+    char   ns[NVS_NS_NAME_MAX_SIZE];
+    char   key[NVS_KEY_NAME_MAX_SIZE];
+    size_t len;
+    char   data[BLOB_SIZE];
+} entry_t;
+
+static SIM_HW_ATTR entry_t entries[ENTRIES];
+static std::mutex          mutex;
+static bool                initialized = false;
+// the namespace names of the open handles, 1 based
+static const char* handles[8];
+
+struct nvs_opaque_iterator_t {
+    char   ns[NVS_NS_NAME_MAX_SIZE];
+    size_t pos;
+};
+
+static entry_t* find(nvs_handle_t handle, const char* key) {
+    const auto it = std::find_if(std::begin(entries), std::end(entries), [&](const auto& entry) {
+        return entry.used && !strcmp(entry.ns, handles[handle - 1]) && !strcmp(entry.key, key);
+    });
+    return it == std::end(entries) ? nullptr : it;
+}
+
+esp_err_t nvs_flash_init(void) {
+    initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    std::lock_guard<std::mutex> lock(mutex);
+    memset(entries, 0, sizeof(entries));
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t /*open_mode*/, nvs_handle_t* out_handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (size_t i = 0; i < std::size(handles); i++) {
+        if (!handles[i]) {
+            handles[i]  = name;
+            *out_handle = i + 1;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    handles[handle - 1] = nullptr;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (length > BLOB_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    auto* entry = find(handle, key);
+    if (!entry) {
+        entry = std::find_if(std::begin(entries), std::end(entries), [](const auto& entry) { return !entry.used; });
+        if (entry == std::end(entries)) {
+            return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        }
+        entry->used = true;
+        strlcpy(entry->ns, handles[handle - 1], sizeof(entry->ns));
+        strlcpy(entry->key, key, sizeof(entry->key));
+    }
+    entry->len = length;
+    memcpy(entry->data, value, length);
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto*                 entry = find(handle, key);
+    if (!entry) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (out_value) {
+        if (*length < entry->len) {
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        }
+        memcpy(out_value, entry->data, entry->len);
+    }
+    *length = entry->len;
+    return ESP_OK;
+}
+
+// a 4 byte entry
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char* key, uint32_t value) {
+    return nvs_set_blob(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char* key, uint32_t* out_value) {
+    size_t len = sizeof(*out_value);
+    return nvs_get_blob(handle, key, out_value, &len);
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto*                       entry = find(handle, key);
+    if (!entry) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    entry->used = false;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t /*handle*/) {
+    return ESP_OK;
+}
+
+// the next entry of the namespace from pos on, the iterator is released at the end as by the IDF
+static esp_err_t seek(nvs_iterator_t* iterator) {
+    auto* it = *iterator;
+    for (; it->pos < ENTRIES; it->pos++) {
+        if (entries[it->pos].used && !strcmp(entries[it->pos].ns, it->ns)) {
+            return ESP_OK;
+        }
+    }
+    delete it;
+    *iterator = nullptr;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_entry_find(
+    const char* /*part_name*/, const char* namespace_name, nvs_type_t /*type*/, nvs_iterator_t* output_iterator) {
+    std::lock_guard<std::mutex> lock(mutex);
+    *output_iterator = new nvs_opaque_iterator_t{};
+    strlcpy((*output_iterator)->ns, namespace_name, sizeof((*output_iterator)->ns));
+    return seek(output_iterator);
+}
+
+esp_err_t nvs_entry_next(nvs_iterator_t* iterator) {
+    std::lock_guard<std::mutex> lock(mutex);
+    (*iterator)->pos++;
+    return seek(iterator);
+}
+
+esp_err_t nvs_entry_info(const nvs_iterator_t iterator, nvs_entry_info_t* out_info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto&                 entry = entries[iterator->pos];
+    strlcpy(out_info->namespace_name, entry.ns, sizeof(out_info->namespace_name));
+    strlcpy(out_info->key, entry.key, sizeof(out_info->key));
+    out_info->type = NVS_TYPE_BLOB;
+    return ESP_OK;
+}
+
+void nvs_release_iterator(nvs_iterator_t iterator) {
+    delete iterator;
+}
@@ -0,0 +1,189 @@
+/*
+ * system.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <malloc.h>
+#include <sys/time.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include "driver/gpio.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_oneshot.h"
+#include "esp_chip_info.h"
+#include "esp_flash.h"
+#include "esp_heap_caps.h"
+#include "esp_mac.h"
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "sim.hpp"
+
+// the device heap is what is left of its 320K after the static data, the process one counts the allocations
+constexpr uint32_t HEAP_SIZE = 240 * 1024;
+
+static std::atomic<uint32_t> min_free = HEAP_SIZE;
+
+void esp_chip_info(esp_chip_info_t* out_info) {
+    *out_info = { .model = 5, .features = CHIP_FEATURE_WIFI_BGN | CHIP_FEATURE_BLE, .revision = 4, .cores = 1 };
+}
+
+esp_err_t esp_flash_get_size(esp_flash_t* /*chip*/, uint32_t* out_size) {
+    *out_size = 4 * 1024 * 1024;
+    return ESP_OK;
+}
+
+uint32_t esp_get_free_heap_size(void) {
+    const auto     info = mallinfo2();
+    const uint32_t used = std::min<size_t>(info.uordblks, HEAP_SIZE);
+    const uint32_t res  = HEAP_SIZE - used;
+    uint32_t       cur  = min_free;
+    while (res < cur && !min_free.compare_exchange_weak(cur, res)) {}
+    return res;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void) {
+    esp_get_free_heap_size();
+    return min_free;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t /*caps*/) {
+    return esp_get_free_heap_size();
+}
+
+const char* esp_get_idf_version(void) {
+    return "v5.3-host";
+}
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t /*type*/) {
+    const uint8_t res[6] = { 0x02, 0x53, 0x49, 0x4D, static_cast<uint8_t>(sim::config.device >> 8),
+        static_cast<uint8_t>(sim::config.device) };
+    std::copy(std::begin(res), std::end(res), mac);
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_configure(const void* /*config*/) {
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(
+    esp_pm_lock_type_t /*lock_type*/, int /*arg*/, const char* /*name*/, esp_pm_lock_handle_t* out_handle) {
+    *out_handle = reinterpret_cast<esp_pm_lock_handle_t>(1);
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t /*handle*/) {
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t /*handle*/) {
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t /*handle*/) {
+    return ESP_OK;
+}
+
+// the mode stats of CONFIG_PM_PROFILING, the host never leaves the full clock
+esp_err_t esp_pm_dump_locks(FILE* stream) {
+    const int64_t now = esp_timer_get_time();
+    fprintf(stream, "\nMode stats:\n%-8s  %-10s  %-10s  %-10s\n", "Mode", "CPU_freq", "Time(us)", "Time(%)");
+    fprintf(stream, "%-8s  %-3dM%-7s %-10lld  %-2d%%\n", "SLEEP", 40, "", 0LL, 0);
+    fprintf(stream, "%-8s  %-3dM%-7s %-10lld  %-2d%%\n", "APB_MIN", 40, "", 0LL, 0);
+    fprintf(stream, "%-8s  %-3dM%-7s %-10lld  %-2d%%\n", "APB_MAX", 160, "", 0LL, 0);
+    fprintf(stream, "%-8s  %-3dM%-7s %-10lld  %-2d%%\n", "CPU_MAX", 160, "", static_cast<long long>(now), 100);
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t /*gpio_num*/) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t /*gpio_num*/, gpio_mode_t /*mode*/) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t /*gpio_num*/, uint32_t /*level*/) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_sleep_sel_dis(gpio_num_t /*gpio_num*/) {
+    return ESP_OK;
+}
+
+// about 1.5V at the pin, 12 bit at 12 dB
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t* /*init_config*/, adc_oneshot_unit_handle_t* ret_unit) {
+    *ret_unit = reinterpret_cast<adc_oneshot_unit_handle_t>(1);
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_config_channel(
+    adc_oneshot_unit_handle_t /*handle*/, adc_channel_t /*channel*/, const adc_oneshot_chan_cfg_t* /*config*/) {
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t /*handle*/, adc_channel_t /*chan*/, int* out_raw) {
+    *out_raw = 1850 + sim::noise(4) * 4;
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_del_unit(adc_oneshot_unit_handle_t /*handle*/) {
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_create_scheme_curve_fitting(
+    const adc_cali_curve_fitting_config_t* /*config*/, adc_cali_handle_t* ret_handle) {
+    *ret_handle = reinterpret_cast<adc_cali_handle_t>(1);
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_delete_scheme_curve_fitting(adc_cali_handle_t /*handle*/) {
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t /*handle*/, int raw, int* voltage) {
+    *voltage = raw * 3300 / 4095;
+    return ESP_OK;
+}
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause(void) {
+    return sim::cold_boot() ? ESP_SLEEP_WAKEUP_UNDEFINED : ESP_SLEEP_WAKEUP_TIMER;
+}
+
+void esp_deep_sleep(uint64_t time_in_us) {
+    sim::deep_sleep(time_in_us);
+}
+
+void esp_default_wake_deep_sleep(void) {}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size) {
+    const size_t len = strlen(src);
+    if (size) {
+        const size_t n = len < size ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// the system time of the device: the RTC clock with its drift, 0 after a power on until SNTP sets it
+extern "C" int gettimeofday(struct timeval* __restrict tv, void* __restrict /*tz*/) noexcept {
+    const int64_t now = sim::system_time_us();
+    tv->tv_sec        = now / 1000000;
+    tv->tv_usec       = now % 1000000;
+    return 0;
+}
+
+extern "C" time_t time(time_t* out) noexcept {
+    const time_t res = sim::system_time_us() / 1000000;
+    if (out) {
+        *out = res;
+    }
+    return res;
+}
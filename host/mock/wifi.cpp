@@ -0,0 +1,133 @@
+/*
+ * wifi.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <time.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_netif_sntp.h"
+#include "esp_wifi.h"
+#include "ip_lease.h"
+#include "provision.h"
+#include "sim.hpp"
+
+/*
+ * provision.c and ip_lease.c of a provisioned device: the events of the connection come after the
+ * simulated latencies, the fast connect cache and the DHCP lease are kept in RTC memory as on the device
+ */
+static const char* TAG = "SIM_WIFI";
+
+constexpr uint32_t LEASE_RENEW_S = 43200; // T1 of a day long lease
+
+typedef struct {
+    bool     valid;
+    time_t   obtained; // system time
+    uint32_t renew;
+} lease_t;
+
+static RTC_DATA_ATTR bool     fast_connect;
+static RTC_DATA_ATTR uint32_t fast_connect_hits;
+static RTC_DATA_ATTR uint32_t fast_connect_misses;
+static RTC_DATA_ATTR lease_t  lease;
+static bool                   lease_applied;
+
+static std::mutex              sntp_mutex;
+static std::condition_variable sntp_done;
+static bool                    synced;
+
+static void connect() {
+    sim::delay_us(sim::config.wifi_start_us);
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, nullptr, 0, portMAX_DELAY);
+    if (sim::chance(sim::config.wifi_fail)) {
+        ESP_LOGW(TAG, "AP not found");
+        if (fast_connect) {
+            fast_connect = false;
+            fast_connect_misses++;
+        }
+        return;
+    }
+    if (fast_connect) {
+        fast_connect_hits++;
+    } else {
+        sim::delay_us(sim::config.scan_us);
+    }
+    sim::delay_us(sim::config.assoc_us);
+    fast_connect = true;
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, nullptr, 0, portMAX_DELAY);
+    const time_t now = time(nullptr);
+    lease_applied    = lease.valid && now >= lease.obtained && now - lease.obtained < lease.renew;
+    if (!lease_applied) {
+        sim::delay_us(sim::config.dhcp_us);
+    }
+    ip_event_got_ip_t event    = {};
+    event.ip_info.ip.addr      = ESP_IP4TOADDR(192, 168, 1, 100 + sim::config.device % 150);
+    event.ip_info.netmask.addr = ESP_IP4TOADDR(255, 255, 255, 0);
+    event.ip_info.gw.addr      = ESP_IP4TOADDR(192, 168, 1, 1);
+    esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &event, sizeof(event), portMAX_DELAY);
+}
+
+void provision_main(void) {
+    ESP_LOGI(TAG, "Already provisioned, starting Wi-Fi STA");
+    sim::radio_used();
+    std::thread(connect).detach();
+}
+
+void wifi_fast_connect_stat(uint32_t* hits, uint32_t* misses) {
+    *hits   = fast_connect_hits;
+    *misses = fast_connect_misses;
+}
+
+void ip_lease_apply(esp_netif_t* /*netif*/) {}
+
+void ip_lease_store(const ip_event_got_ip_t* /*event*/) {
+    if (!lease_applied) {
+        lease = { .valid = true, .obtained = time(nullptr), .renew = LEASE_RENEW_S };
+    }
+}
+
+void ip_lease_invalidate(void) {
+    lease.valid = false;
+}
+
+esp_err_t esp_wifi_sta_get_rssi(int* rssi) {
+    *rssi = sim::config.rssi + sim::noise(3);
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_init(void) {
+    return ESP_OK;
+}
+
+// the server answers with the true time after the round trip
+esp_err_t esp_netif_sntp_init(const esp_sntp_config_t* config) {
+    const auto cb = config->sync_cb;
+    std::thread([cb]() {
+        sim::delay_us(sim::config.sntp_us);
+        sim::set_system_time_us(sim::true_time_us());
+        timeval tv;
+        gettimeofday(&tv, nullptr);
+        if (cb) {
+            cb(&tv);
+        }
+        std::lock_guard<std::mutex> lock(sntp_mutex);
+        synced = true;
+        sntp_done.notify_all();
+    }).detach();
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_sntp_sync_wait(TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(sntp_mutex);
+    const auto                   real = sim::to_real_us(static_cast<int64_t>(ticks) * portTICK_PERIOD_MS * 1000);
+    return sntp_done.wait_for(lock, std::chrono::microseconds(real), []() { return synced; }) ? ESP_OK
+                                                                                                : ESP_ERR_TIMEOUT;
+}
+
+void esp_netif_sntp_deinit(void) {}
@@ -0,0 +1,137 @@
+/*
+ * payload_fixtures.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "batch.hpp"
+#include "esp_mac.h"
+#include "json_helper.hpp"
+#include "payload.hpp"
+
+/*
+ * tools/fixtures/payload_binary.jsonl: CONFIG_PAYLOAD_BINARY messages of main/payload.cpp, a line per case,
+ * {"name", "hex", "decoded"} where "decoded" is what tools/payload_decode.py must return for "hex".
+ * "decoded" is built from the inputs here, not from the encoder output.
+ * payload_fixtures > tools/fixtures/payload_binary.jsonl
+ */
+static const uint8_t MAC[6] = { 0xA0, 0xB1, 0xC2, 0xD3, 0xE4, 0xF5 };
+
+static std::vector<batch::sample_t> samples;
+
+namespace batch {
+size_t size() {
+    return samples.size();
+}
+
+const sample_t& at(size_t idx) {
+    return samples[idx];
+}
+
+const sample_t& latest() {
+    return samples.back();
+}
+} // namespace batch
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t /*type*/) {
+    memcpy(mac, MAC, sizeof(MAC));
+    return ESP_OK;
+}
+
+static char json_buf[4096];
+
+static std::string hex(const std::string& data) {
+    std::string res;
+    char        byte[3];
+    for (const unsigned char ch : data) {
+        snprintf(byte, sizeof(byte), "%02x", ch);
+        res += byte;
+    }
+    return res;
+}
+
+static void add_sample(json::Writer& out, const batch::sample_t& sample) {
+    const auto& result = sample.result;
+    out.begin_object().add("boot", sample.boot_count);
+    if (sample.time) {
+        out.add("time", sample.time);
+    }
+    if (result.bme280) {
+        out.add_formated("temperature", "%.2f", result.bme280->temperature);
+        out.add_formated("humidity", "%.2f", result.bme280->humidity);
+        out.add_formated("pressure", "%.2f", result.bme280->pressure);
+    }
+    if (result.sht3x) {
+        out.add_formated("sht3x_temperature", "%.2f", result.sht3x->temperature);
+        out.add_formated("sht3x_humidity", "%.2f", result.sht3x->humidity);
+    }
+    if (result.light) {
+        out.add_formated("light", "%.2f", *result.light);
+    }
+    if (result.battery) {
+        out.add_formated("battery", "%.3f", *result.battery);
+    }
+    out.end_object();
+}
+
+static void sensors_case(
+    const char* name, uint32_t seq, const payload::link_t& link, std::vector<batch::sample_t> batch) {
+    samples = std::move(batch);
+    json::Writer out(json_buf, sizeof(json_buf));
+    out.begin_object().add("name", name).add("hex", hex(payload::sensors(link, seq, samples.size())).c_str());
+    out.begin_object("decoded").add("mac", "A0B1C2D3E4F5").add("seq", seq);
+    out.begin_object("link")
+        .add("rssi", link.rssi)
+        .add("fast_connect_hits", link.fast_connect_hits)
+        .add("fast_connect_misses", link.fast_connect_misses)
+        .end_object();
+    out.begin_array("samples");
+    for (const auto& sample : samples) {
+        add_sample(out, sample);
+    }
+    out.end_array().end_object().end_object();
+    puts(out.c_str());
+}
+
+// rssi_quantized - of CONFIG_ADVERTISEMENT_RSSI_STEP 5, host/sdkconfig.payload_binary
+static void advertisement_case(const char* name, const payload::advertisement_t& adv, int rssi_quantized) {
+    const auto*  ip = reinterpret_cast<const uint8_t*>(&adv.ip);
+    char         ip_str[16];
+    json::Writer out(json_buf, sizeof(json_buf));
+    snprintf(ip_str, sizeof(ip_str), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+    out.begin_object().add("name", name).add("hex", hex(payload::advertisement(adv)).c_str());
+    out.begin_object("decoded")
+        .add("ip", ip_str)
+        .add("mac", "A0B1C2D3E4F5")
+        .add("rssi", rssi_quantized)
+        .add("app_name", CONFIG_APP_NAME)
+        .end_object()
+        .end_object();
+    puts(out.c_str());
+}
+
+int main() {
+    const sensors::bme280_t bme280 = { .temperature = 21.37f, .humidity = 53.42f, .pressure = 1018.45f };
+    const sensors::bme280_t frost  = { .temperature = -12.34f, .humidity = 91.5f, .pressure = 987.65f };
+    const sensors::sht3x_t  sht3x  = { .temperature = 21.12f, .humidity = 52.87f };
+
+    sensors_case("bme280 only, clock not synced", 1, { -61, 0, 0 }, { { 1, 0, { .bme280 = bme280 } } });
+    sensors_case("all sensors with time", 4000000000, { -67, 1234, 5 },
+        { { 42, 1792195260, { .bme280 = bme280, .sht3x = sht3x, .light = 345.67f, .battery = 3.912f } } });
+    sensors_case("batch, mixed flags, the oldest first", 77, { -90, 70000, 3 },
+        {
+            { 100, 1792195200, { .bme280 = frost, .battery = 3.3f } },
+            { 101, 0, { .sht3x = sht3x, .light = 0.0f } },
+            { 102, 1792195320, { .bme280 = bme280, .sht3x = sht3x, .light = 12.5f, .battery = 4.2f } },
+        });
+    sensors_case("no sensor answered", 78, { -55, 1, 1 }, { { 7, 1792195380, {} } });
+
+    advertisement_case("advertisement", { .ip = { ESP_IP4TOADDR(192, 168, 1, 101) }, .rssi = -67 }, -65);
+    advertisement_case("advertisement, strong signal", { .ip = { ESP_IP4TOADDR(10, 0, 0, 7) }, .rssi = -32 }, -30);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""sdkconfig.h for the host build, the way idf.py generates it for the device.
+
+The values come from sdkconfig, then the host overrides in their order, then the defaults
+of the project Kconfig options missing in all (a stale sdkconfig has not seen them yet).
+
+host/sdkconfig_h.py sdkconfig main/Kconfig.projbuild sdkconfig.h host/sdkconfig.host [overrides ...]
+"-" as sdkconfig.h writes to stdout.
+"""
+import re
+import sys
+
+VALUE = re.compile(r"^(CONFIG_\w+)=(.*)$")
+NOT_SET = re.compile(r"^# (CONFIG_\w+) is not set$")
+
+
+def read_config(path, values):
+    with open(path) as lines:
+        for line in lines:
+            line = line.strip()
+            if m := VALUE.match(line):
+                values[m[1]] = m[2]
+            elif m := NOT_SET.match(line):
+                values[m[1]] = "n"
+
+
+def kconfig_defaults(path):
+    """(name, default) of the options, "y" for the default member of a choice."""
+    defaults, choices = {}, []
+    name, kind, choice = None, None, None
+    with open(path) as lines:
+        for line in lines:
+            words = line.split()
+            if not words:
+                continue
+            if words[0] in ("config", "menuconfig"):
+                name, kind = "CONFIG_" + words[1], None
+                if choice is not None:
+                    choice["members"].append(name)
+            elif words[0] == "choice":
+                choice, name = {"default": None, "members": []}, None
+            elif words[0] == "endchoice":
+                choices.append(choice)
+                choice = None
+            elif words[0] in ("bool", "int", "hex", "string"):
+                kind = words[0]
+            elif words[0] == "default" and "if" not in words:
+                if name is None and choice is not None:
+                    choice["default"] = "CONFIG_" + words[1]
+                elif name is not None and name not in defaults and kind is not None:
+                    defaults[name] = line.strip()[len("default"):].strip()
+    return defaults, choices
+
+
+def main(sdkconfig, kconfig, output, *overrides):
+    values = {}
+    read_config(sdkconfig, values)
+    for path in overrides:
+        read_config(path, values)
+    defaults, choices = kconfig_defaults(kconfig)
+    for choice in choices:
+        if choice["default"] and not any(values.get(member) == "y" for member in choice["members"]):
+            for member in choice["members"]:
+                values.setdefault(member, "y" if member == choice["default"] else "n")
+    for name, value in defaults.items():
+        values.setdefault(name, value)
+    lines = ["/* generated by host/sdkconfig_h.py */", "#pragma once"]
+    for name, value in values.items():
+        if value == "y":
+            lines.append(f"#define {name} 1")
+        elif value != "n":
+            lines.append(f"#define {name} {value}")
+    text = "\n".join(lines) + "\n"
+    if output == "-":
+        sys.stdout.write(text)
+        return
+    # not rewritten when unchanged, nothing is rebuilt
+    try:
+        with open(output) as old:
+            if old.read() == text:
+                return
+    except FileNotFoundError:
+        pass
+    with open(output, "w") as out:
+        out.write(text)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 4:
+        sys.exit(__doc__)
+    main(*sys.argv[1:])
@@ -0,0 +1,217 @@
+/*
+ * sim.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "sim.hpp"
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "esp_sleep.h"
+
+extern "C" void app_main(void);
+// the linker provides them for the sections named as C identifiers
+extern "C" uint8_t __start_rtc_data[], __stop_rtc_data[];
+extern "C" uint8_t __start_sim_hw[], __stop_sim_hw[];
+
+namespace sim {
+config_t config = {
+    .boot_us       = 50000,
+    .i2c_khz       = 100,
+    .wifi_start_us = 40000,
+    .scan_us       = 1500000,
+    .assoc_us      = 150000,
+    .dhcp_us       = 600000,
+    .sntp_us       = 80000,
+    .connect_us    = 20000,
+    .wifi_fail     = 0,
+    .power_loss    = 0,
+    .rssi          = -60,
+    .rtc_drift_ppm = 150,
+    .scale         = 1,
+    .broker        = {},
+    .device        = 0,
+    .seed          = 1,
+    .log_level     = 1,
+};
+
+constexpr int64_t EPOCH_US      = 1792195200LL * 1000000; // Oct 17, 2026
+constexpr int64_t WAKE_LIMIT_US = 60 * 1000000;           // simulated, the hang watchdog
+constexpr int64_t RESET_US      = 300000;                 // a crashed wake to the next boot
+
+// shared with the wake process
+typedef struct {
+    bool    cold;
+    int64_t true_us;      // epoch at the reset of the wake
+    int64_t rtc_error_us; // system - true
+    bool    slept;
+    wake_t  wake;
+} slot_t;
+
+static slot_t*                               slot;
+static uint8_t*                              slot_rtc;
+static uint8_t*                              slot_hw;
+static std::chrono::steady_clock::time_point reset_at; // real, boot_us before app_main
+static std::mutex                            mutex;
+static std::mt19937                          rng;
+static std::atomic<int64_t>                  sent;
+static std::atomic<int64_t>                  received;
+static std::atomic<bool>                     radio;
+
+static size_t rtc_size() {
+    return __stop_rtc_data - __start_rtc_data;
+}
+
+static size_t hw_size() {
+    return __stop_sim_hw - __start_sim_hw;
+}
+
+void delay_us(int64_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(to_real_us(us)));
+}
+
+bool chance(double probability) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::uniform_real_distribution<double>(0, 1)(rng) < probability;
+}
+
+int noise(int amplitude) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::uniform_int_distribution<int>(-amplitude, amplitude)(rng);
+}
+
+int64_t to_real_us(int64_t us) {
+    return static_cast<int64_t>(us * config.scale);
+}
+
+int64_t uptime_us() {
+    const auto real = std::chrono::steady_clock::now() - reset_at;
+    return config.boot_us + std::chrono::duration_cast<std::chrono::microseconds>(real).count() / config.scale;
+}
+
+bool cold_boot() {
+    return slot->cold;
+}
+
+int64_t true_time_us() {
+    return slot->true_us + uptime_us();
+}
+
+int64_t system_time_us() {
+    return true_time_us() + slot->rtc_error_us;
+}
+
+void set_system_time_us(int64_t us) {
+    slot->rtc_error_us = us - true_time_us();
+}
+
+void radio_used() {
+    radio = true;
+}
+
+void count_sent(size_t bytes) {
+    sent += bytes;
+}
+
+void count_received(size_t bytes) {
+    received += bytes;
+}
+
+void deep_sleep(int64_t us) {
+    slot->wake = {
+        .radio          = radio,
+        .awake_us       = uptime_us(),
+        .sleep_us       = us,
+        .bytes_sent     = sent,
+        .bytes_received = received,
+    };
+    memcpy(slot_rtc, __start_rtc_data, rtc_size());
+    memcpy(slot_hw, __start_sim_hw, hw_size());
+    slot->slept = true;
+    fflush(stdout);
+    fflush(stderr);
+    _exit(0);
+}
+
+[[noreturn]] static void wake(int cycle) {
+    reset_at = std::chrono::steady_clock::now() - std::chrono::microseconds(to_real_us(config.boot_us));
+    rng.seed(config.seed * 1000003u + config.device * 7919u + cycle);
+    if (!slot->cold) {
+        memcpy(__start_rtc_data, slot_rtc, rtc_size());
+    }
+    memcpy(__start_sim_hw, slot_hw, hw_size());
+    alarm(std::max<int64_t>(to_real_us(WAKE_LIMIT_US) / 1000000, 2));
+    if (!slot->cold) {
+        esp_wake_deep_sleep();
+    }
+    app_main();
+    // the main task returned, nothing puts the device to sleep
+    pause();
+    _exit(1);
+}
+
+void run_device(int cycles, wake_t* wakes, outcome_e* outcomes) {
+    const size_t size = sizeof(slot_t) + rtc_size() + hw_size();
+    auto* mem = static_cast<uint8_t*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (mem == MAP_FAILED) {
+        perror("mmap");
+        return;
+    }
+    slot     = reinterpret_cast<slot_t*>(mem);
+    slot_rtc = mem + sizeof(slot_t);
+    slot_hw  = slot_rtc + rtc_size();
+    // the sections of this process are never touched by the application, the power on image
+    memcpy(slot_hw, __start_sim_hw, hw_size());
+    slot->cold         = true;
+    slot->true_us      = EPOCH_US + config.device * 1000003LL;
+    slot->rtc_error_us = -slot->true_us;
+    std::mt19937 outage(config.seed * 1000003u + config.device * 7919u);
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        slot->slept    = false;
+        const auto pid = fork();
+        if (pid == 0) {
+            wake(cycle);
+        }
+        const auto started = std::chrono::steady_clock::now();
+        int        status  = 0;
+        waitpid(pid, &status, 0);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && slot->slept) {
+            wakes[cycle]    = slot->wake;
+            outcomes[cycle] = outcome_e::OK;
+            slot->cold      = false;
+            slot->true_us += slot->wake.awake_us + slot->wake.sleep_us;
+            // the main crystal is exact, the RTC slow clock drifts in the deep sleep
+            slot->rtc_error_us += static_cast<int64_t>(slot->wake.sleep_us * config.rtc_drift_ppm / 1000000);
+            // the RTC memory and the system time are lost, the flash is kept
+            if (std::uniform_real_distribution<double>(0, 1)(outage) < config.power_loss) {
+                slot->cold         = true;
+                slot->rtc_error_us = -slot->true_us;
+            }
+            continue;
+        }
+        const auto real = std::chrono::steady_clock::now() - started;
+        wakes[cycle]    = {};
+        wakes[cycle].awake_us
+            = config.boot_us + std::chrono::duration_cast<std::chrono::microseconds>(real).count() / config.scale;
+        outcomes[cycle] = WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM ? outcome_e::HUNG : outcome_e::CRASHED;
+        fprintf(stderr, "device %d wake %d %s, status 0x%x\n", config.device, cycle,
+            outcomes[cycle] == outcome_e::HUNG ? "hung" : "crashed", status);
+        // the RTC memory is lost, the system time starts from 0
+        slot->cold = true;
+        slot->true_us += wakes[cycle].awake_us + RESET_US;
+        slot->rtc_error_us = -slot->true_us;
+    }
+    munmap(mem, size);
+}
+} // namespace sim
@@ -0,0 +1,82 @@
+/*
+ * sim.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// the flash of the simulated device: kept across the wakes and the crashes, unlike RTC_DATA_ATTR
+#define SIM_HW_ATTR __attribute__((section("sim_hw")))
+
+/*
+ * the device is a process, every wake a fork of it. the RTC_DATA_ATTR and SIM_HW_ATTR sections of the wake
+ * are handed to the next one by deep_sleep(). the time is simulated: the mocked latencies, the esp_timer,
+ * the ticks and the system time run at config.scale of the real time
+ */
+namespace sim {
+typedef struct {
+    int64_t     boot_us;       // reset to app_main
+    int         i2c_khz;       // bus clock of the mocked transfers
+    int64_t     wifi_start_us; // esp_wifi_start to WIFI_EVENT_STA_START
+    int64_t     scan_us;       // full scan, skipped by the fast connect
+    int64_t     assoc_us;      // authentication and association
+    int64_t     dhcp_us;       // skipped with a stored lease
+    int64_t     sntp_us;       // request to the response
+    int64_t     connect_us;    // TCP and MQTT handshakes, tools/mqtt_bench.py proxy delays the rest
+    double      wifi_fail;     // probability the AP is not reached on a wake
+    double      power_loss;    // probability the power is lost in a deep sleep, the RTC memory with it
+    int         rssi;          // dBm, +-3 noise
+    double      rtc_drift_ppm; // of the RTC slow clock in the deep sleep
+    double      scale;         // real time per simulated time, 0.1 - ten times faster
+    std::string broker;        // host:port replacing CONFIG_BROKER_URL
+    int         device;        // number, the MAC and the IP address
+    unsigned    seed;
+    int         log_level; // esp_log_level_t
+} config_t;
+
+typedef struct {
+    bool    radio;          // provision_main() was called
+    int64_t awake_us;       // app_main to esp_deep_sleep, the boot included
+    int64_t sleep_us;       // requested
+    int64_t bytes_sent;     // MQTT over TCP
+    int64_t bytes_received; // MQTT over TCP
+} wake_t;
+
+extern config_t config;
+
+// the mocked latency, simulated
+void delay_us(int64_t us);
+// deterministic per device and wake
+bool chance(double probability);
+int  noise(int amplitude);
+// the esp_timer time: since the reset of this wake
+int64_t uptime_us();
+// simulated time to the real one and back
+int64_t to_real_us(int64_t us);
+bool    cold_boot();
+// epoch, us
+int64_t true_time_us();
+int64_t system_time_us();
+void    set_system_time_us(int64_t us);
+void    radio_used();
+void    count_sent(size_t bytes);
+void    count_received(size_t bytes);
+// the end of the wake, the state goes to the next one
+[[noreturn]] void deep_sleep(int64_t us);
+
+enum class outcome_e : int32_t {
+    NONE,
+    OK,
+    CRASHED, // aborted, the next wake is a cold boot
+    HUNG,    // no deep sleep within the limit, the watchdog resets it to a cold boot
+};
+
+// runs config.device through the wakes from a cold boot, a record per wake
+void run_device(int cycles, wake_t* wakes, outcome_e* outcomes);
+} // namespace sim
@@ -0,0 +1,157 @@
+/*
+ * wake_sim.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "esp_log.h"
+#include "sim.hpp"
+
+/*
+ * wake cycle benchmark: the application of main/ on simulated devices, every wake a process.
+ * the awake time (reset to the deep sleep) distribution, the radio and the sensor only wakes apart,
+ * and the MQTT bytes per wake
+ */
+static const char* const USAGE
+    = "wake_sim [--devices 20] [--cycles 100] [--broker localhost:1883] [--scale 1] [--seed 1] [-v]\n"
+      "         [--boot-ms 50] [--i2c-khz 100] [--wifi-start-ms 40] [--scan-ms 1500] [--assoc-ms 150]\n"
+      "         [--dhcp-ms 600] [--sntp-ms 80] [--connect-ms 20] [--wifi-fail 0] [--power-loss 0] [--rssi -60]\n"
+      "         [--drift-ppm 150]\n";
+
+static int64_t ms(const char* arg) {
+    return static_cast<int64_t>(atof(arg) * 1000);
+}
+
+static std::string percentiles(std::vector<double> values) {
+    if (values.empty()) {
+        return "n=0";
+    }
+    std::sort(values.begin(), values.end());
+    const auto pick = [&](double p) { return values[std::min(values.size() - 1, size_t(p * values.size()))]; };
+    double     sum  = 0;
+    for (const auto val : values) {
+        sum += val;
+    }
+    char res[160];
+    snprintf(res, sizeof(res), "n=%zu p50=%.1f p90=%.1f p99=%.1f max=%.1f mean=%.1f", values.size(), pick(0.5),
+        pick(0.9), pick(0.99), values.back(), sum / values.size());
+    return res;
+}
+
+int main(int argc, char* argv[]) {
+    enum { BOOT = 256, I2C, WIFI_START, SCAN, ASSOC, DHCP, SNTP, CONNECT, WIFI_FAIL, POWER_LOSS, RSSI, DRIFT };
+    static const option options[] = {
+        { "devices", required_argument, nullptr, 'd' },
+        { "cycles", required_argument, nullptr, 'c' },
+        { "broker", required_argument, nullptr, 'b' },
+        { "scale", required_argument, nullptr, 's' },
+        { "seed", required_argument, nullptr, 'r' },
+        { "boot-ms", required_argument, nullptr, BOOT },
+        { "i2c-khz", required_argument, nullptr, I2C },
+        { "wifi-start-ms", required_argument, nullptr, WIFI_START },
+        { "scan-ms", required_argument, nullptr, SCAN },
+        { "assoc-ms", required_argument, nullptr, ASSOC },
+        { "dhcp-ms", required_argument, nullptr, DHCP },
+        { "sntp-ms", required_argument, nullptr, SNTP },
+        { "connect-ms", required_argument, nullptr, CONNECT },
+        { "wifi-fail", required_argument, nullptr, WIFI_FAIL },
+        { "power-loss", required_argument, nullptr, POWER_LOSS },
+        { "rssi", required_argument, nullptr, RSSI },
+        { "drift-ppm", required_argument, nullptr, DRIFT },
+        { "help", no_argument, nullptr, 'h' },
+        { nullptr, 0, nullptr, 0 },
+    };
+    int   devices = 20;
+    int   cycles  = 100;
+    auto& config  = sim::config;
+    config.broker = "localhost:1883";
+    for (int opt; (opt = getopt_long(argc, argv, "d:c:b:s:r:vh", options, nullptr)) != -1;) {
+        switch (opt) {
+            case 'd': devices = atoi(optarg); break;
+            case 'c': cycles = atoi(optarg); break;
+            case 'b': config.broker = optarg; break;
+            case 's': config.scale = atof(optarg); break;
+            case 'r': config.seed = atoi(optarg); break;
+            case 'v': config.log_level = ESP_LOG_INFO; break;
+            case BOOT: config.boot_us = ms(optarg); break;
+            case I2C: config.i2c_khz = atoi(optarg); break;
+            case WIFI_START: config.wifi_start_us = ms(optarg); break;
+            case SCAN: config.scan_us = ms(optarg); break;
+            case ASSOC: config.assoc_us = ms(optarg); break;
+            case DHCP: config.dhcp_us = ms(optarg); break;
+            case SNTP: config.sntp_us = ms(optarg); break;
+            case CONNECT: config.connect_us = ms(optarg); break;
+            case WIFI_FAIL: config.wifi_fail = atof(optarg); break;
+            case POWER_LOSS: config.power_loss = atof(optarg); break;
+            case RSSI: config.rssi = atoi(optarg); break;
+            case DRIFT: config.rtc_drift_ppm = atof(optarg); break;
+            default: fputs(USAGE, stderr); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (devices <= 0 || cycles <= 0 || config.scale <= 0 || config.i2c_khz <= 0) {
+        fputs(USAGE, stderr);
+        return 2;
+    }
+    const size_t wakes_size    = sizeof(sim::wake_t) * devices * cycles;
+    const size_t outcomes_size = sizeof(sim::outcome_e) * devices * cycles;
+    void*        mem = mmap(nullptr, wakes_size + outcomes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+        -1, 0);
+    if (mem == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    auto* wakes    = static_cast<sim::wake_t*>(mem);
+    auto* outcomes = reinterpret_cast<sim::outcome_e*>(static_cast<char*>(mem) + wakes_size);
+    printf("%d devices x %d wakes, scale %g, broker %s\n", devices, cycles, config.scale, config.broker.c_str());
+    fflush(stdout);
+    for (int i = 0; i < devices; i++) {
+        if (fork() == 0) {
+            config.device = i + 1;
+            sim::run_device(cycles, wakes + i * cycles, outcomes + i * cycles);
+            _exit(0);
+        }
+    }
+    while (wait(nullptr) > 0) {}
+
+    std::vector<double> all, radio, sensors, sent;
+    int                 ok = 0, crashed = 0, hung = 0;
+    int64_t             sent_total = 0, received_total = 0;
+    for (int i = 0; i < devices * cycles; i++) {
+        switch (outcomes[i]) {
+            case sim::outcome_e::OK: ok++; break;
+            case sim::outcome_e::CRASHED: crashed++; break;
+            case sim::outcome_e::HUNG: hung++; break;
+            case sim::outcome_e::NONE: break;
+        }
+        if (outcomes[i] != sim::outcome_e::OK) {
+            continue;
+        }
+        const auto& wake  = wakes[i];
+        const auto  awake = wake.awake_us / 1000.;
+        all.push_back(awake);
+        (wake.radio ? radio : sensors).push_back(awake);
+        if (wake.radio) {
+            sent.push_back(wake.bytes_sent);
+        }
+        sent_total += wake.bytes_sent;
+        received_total += wake.bytes_received;
+    }
+    printf("wakes %d: ok %d crashed %d hung %d\n", devices * cycles, ok, crashed, hung);
+    printf("awake ms, all          %s\n", percentiles(all).c_str());
+    printf("awake ms, radio        %s\n", percentiles(radio).c_str());
+    printf("awake ms, sensors only %s\n", percentiles(sensors).c_str());
+    printf("bytes sent, radio wake %s\n", percentiles(sent).c_str());
+    printf("bytes sent %lld, received %lld\n", static_cast<long long>(sent_total),
+        static_cast<long long>(received_total));
+    return ok == devices * cycles ? 0 : 1;
+}
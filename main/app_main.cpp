@@ -5,6 +5,8 @@
  */
 
 #include <memory>
+#include <algorithm>
+#include <optional>
 #include <stdio.h>
 #include <inttypes.h>
 #include <chrono>
@@ -33,24 +35,50 @@
 #include "esp_event_cxx.hpp"
 #include "esp_timer_cxx.hpp"
 
-#include "json_helper.hpp"
+#include "payload.hpp"
 #include "provision.h"
+#include "ip_lease.h"
 #include "mqtt_wrapper.hpp"
+#include "outbox.hpp"
 #include "blink.hpp"
 #include "collector.hpp"
 #include "deepsleep.hpp"
+#include "batch.hpp"
+#include "timing.hpp"
+#include "timekeeping.hpp"
+#include "report.hpp"
+#include "power.hpp"
+#include "diag.hpp"
+#include "stats.hpp"
+#include "state.hpp"
+#include "wake_stub.hpp"
 #include "utils.hpp"
 
 using namespace std::chrono_literals;
 
-std::shared_ptr<idf::event::ESPEventLoop> el;
-std::unique_ptr<sensors::CCollector>      sensors_mng;
-std::unique_ptr<mqtt::CMQTTWrapper>       mqtt_mng;
-static const char*                        TAG = "APP";
-
 static EventGroupHandle_t app_main_event_group;
 constexpr int             SENSORS_DONE         = BIT0;
 constexpr int             MQTT_CONNECTED_EVENT = BIT1;
+constexpr int             MQTT_CREATED         = BIT2; // mqtt_mng is set, the transport may connect before
+
+struct sensors_done {
+    void operator()(const sensors::result_t& result) const {
+        stats::add(result);
+        timing::mark(timing::phase_e::SENSORS_DONE);
+        xEventGroupSetBits(app_main_event_group, SENSORS_DONE);
+    }
+};
+
+std::shared_ptr<idf::event::ESPEventLoop>          el;
+std::optional<sensors::collector_t<sensors_done>> sensors_mng; // static storage, emplaced on every wake
+std::unique_ptr<mqtt::CMQTTWrapper>                mqtt_mng;
+static payload::link_t                             wake_link; // goes with the sensors
+static const char*                                 TAG = "APP";
+
+void print_heap(const char* stage) {
+    ESP_LOGI(TAG, "[%s] Minimum free heap size: %" PRIu32 " bytes", stage, esp_get_minimum_free_heap_size());
+    ESP_LOGI(TAG, "[%s] Free memory: %" PRIu32 " bytes", stage, esp_get_free_heap_size());
+}
 
 void print_info() {
     /* Print chip information */
@@ -74,29 +102,47 @@ void print_info() {
     ESP_LOGI(TAG, "%" PRIu32 "MB %s flash\n", flash_size / (uint32_t)(1024 * 1024),
         (chip_info.features & CHIP_FEATURE_EMB_FLASH) ? "embedded" : "external");
 
-    ESP_LOGI(TAG, "Minimum free heap size: %" PRIu32 " bytes\n", esp_get_minimum_free_heap_size());
-
-    ESP_LOGI(TAG, "Free memory: %" PRIu32 " bytes", esp_get_free_heap_size());
+    print_heap("startup");
     ESP_LOGI(TAG, "IDF version: %s", esp_get_idf_version());
 }
 
 static void event_got_ip_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
     ip_event_got_ip_t* event = (ip_event_got_ip_t*)event_data;
     ESP_LOGI(TAG, "Connected with IP Address: %s", utils::to_Str(event->ip_info.ip).c_str());
+    timing::mark(timing::phase_e::GOT_IP);
+    ip_lease_store(event);
     /* Signal main application to continue execution */
 
-    mqtt_mng =
-        std::make_unique<mqtt::CMQTTWrapper>([]() { xEventGroupSetBits(app_main_event_group, MQTT_CONNECTED_EVENT); });
-    auto json_obj = json::CreateObject();
-    cJSON_AddStringToObject(json_obj.get(), "app_name", CONFIG_APP_NAME);
-    cJSON_AddStringToObject(json_obj.get(), "ip", utils::to_Str(event->ip_info.ip).c_str());
-    int rssi;
-    ESP_ERROR_CHECK(esp_wifi_sta_get_rssi(&rssi));
-    cJSON_AddNumberToObject(json_obj.get(), "rssi", rssi);
+    mqtt_mng = std::make_unique<mqtt::CMQTTWrapper>([]() {
+        timing::mark(timing::phase_e::MQTT_CONNECTED);
+        xEventGroupSetBits(app_main_event_group, MQTT_CONNECTED_EVENT);
+    });
+    xEventGroupSetBits(app_main_event_group, MQTT_CREATED);
+    ESP_ERROR_CHECK(esp_wifi_sta_get_rssi(&wake_link.rssi));
+    wifi_fast_connect_stat(&wake_link.fast_connect_hits, &wake_link.fast_connect_misses);
 
-    cJSON_AddStringToObject(json_obj.get(), "mac", utils::get_mac().c_str());
+    const std::string topic = std::string(CONFIG_MQTT_TOPIC_ADVERTISEMENT) + "/" + utils::get_mac();
+    const auto        adv   = payload::advertisement({ .ip = event->ip_info.ip, .rssi = wake_link.rssi });
+    // retained, an unchanged one is not sent again. recorded only once it is in the outbox
+    if (!adv.empty() && state::due(topic, adv) && mqtt_mng->publish(topic, adv, false, true)) {
+        state::pending(topic, adv);
+    }
+    if (timekeeping::sync_due()) {
+        timekeeping::sync();
+    }
+}
 
-    mqtt_mng->publish(CONFIG_MQTT_TOPIC_ADVERTISEMENT, PrintUnformatted(json_obj));
+static void event_wifi_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
+    switch (event_id) {
+        case WIFI_EVENT_STA_START:
+            timing::mark(timing::phase_e::WIFI_START);
+            break;
+        case WIFI_EVENT_STA_CONNECTED:
+            timing::mark(timing::phase_e::ASSOCIATED);
+            break;
+        default:
+            break;
+    }
 }
 
 void init() {
@@ -111,6 +157,8 @@ void init() {
         /* Retry nvs_flash_init */
         ESP_ERROR_CHECK(nvs_flash_init());
     }
+    timing::mark(timing::phase_e::NVS_INIT);
+    power::init();
 
     /* Initialize TCP/IP */
     ESP_ERROR_CHECK(esp_netif_init());
@@ -118,39 +166,123 @@ void init() {
     /* Initialize the event loop */
     el = std::make_shared<idf::event::ESPEventLoop>();
     ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &event_got_ip_handler, NULL));
+    ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &event_wifi_handler, NULL));
     blink::init();
-    sensors_mng =
-        std::make_unique<sensors::CCollector>([](auto) { xEventGroupSetBits(app_main_event_group, SENSORS_DONE); });
+    sensors_mng.emplace(sensors_done{});
+}
+
+static TickType_t remaining(TickType_t deadline) {
+    const auto left = static_cast<int32_t>(deadline - xTaskGetTickCount());
+    return left > 0 ? left : 0;
+}
+
+// a message of one sample fits an outbox slot, a larger batch is split
+static_assert(CONFIG_MQTT_OUTBOX_SLOT_SIZE
+              >= sizeof(CONFIG_MQTT_TOPIC_SENSORS) + sizeof("/A0B1C2D3E4F5") + payload::sensors_max(1));
+
+// the oldest samples which fit room, their count shrinks with the overflow
+static std::string fitting(uint32_t seq, size_t room, size_t& count) {
+    count = batch::size();
+    while (count) {
+        auto msg = payload::sensors(wake_link, seq, count);
+        if (!msg.empty() && msg.size() <= room) {
+            return msg;
+        }
+        count = msg.empty() ? count / 2 : std::min(count - 1, count * room / msg.size());
+    }
+    return {};
+}
+
+// the batch is delivered once all of it is in the outbox, the messages which made it leave the batch anyway
+static bool publish_batch() {
+    const std::string topic = std::string(CONFIG_MQTT_TOPIC_SENSORS) + "/" + utils::get_mac();
+    const size_t      room  = mqtt::outbox::room(topic);
+    while (batch::size()) {
+        const auto seq = mqtt_mng->reserve();
+        size_t     count;
+        const auto msg = fitting(seq, room, count);
+        if (msg.empty()) {
+            ESP_LOGE(TAG, "a sample does not fit %d bytes", room);
+            return false;
+        }
+        // the acknowledged messages free their slots
+        if (!mqtt_mng->publish(topic, msg, true, false, seq)
+            && !(mqtt_mng->flush(5s) && mqtt_mng->publish(topic, msg, true, false, seq))) {
+            return false;
+        }
+        if (count == batch::size()) {
+            report::published(batch::latest().result);
+            diag::published();
+            stats::published();
+        }
+        batch::uploaded(count);
+    }
+    return true;
 }
 
 extern "C" void app_main(void) {
+    timing::mark(timing::phase_e::BOOT);
     ESP_LOGI(TAG, "[APP] Startup..");
     print_info();
     init();
     blink::set(blink::led_state_e::FAST);
-    provision_main();
+    const TickType_t deadline = xTaskGetTickCount() + 10000 / portTICK_PERIOD_MS;
+    wake_stub::drain([](int boot_count, std::chrono::microseconds age, const sensors::bme280_t& val) {
+        sensors::result_t result;
+        result.bme280 = val;
+        stats::add(result);
+        if (report::changed(result)) {
+            batch::push(result, boot_count, age);
+        }
+    });
+    // the batch schedule assumes the sample is stored, with the dead-band it is known after the measurement
+    const bool upload_predicted = batch::upload_due();
+    bool       upload           = !mqtt::outbox::empty() || report::heartbeat_due()
+                  || (upload_predicted && !report::deadband_enabled());
+    if (upload) {
+        provision_main();
+        print_heap("provisioned");
+    }
     ESP_LOGI(TAG, "started");
-    const auto uxBits = xEventGroupWaitBits(app_main_event_group, SENSORS_DONE | MQTT_CONNECTED_EVENT, pdTRUE, pdTRUE,
-        10000 / portTICK_PERIOD_MS);
-    blink::set(blink::led_state_e::ON);
-    ESP_LOGI(TAG, "wrapping");
-    if (uxBits & MQTT_CONNECTED_EVENT) {
-        const auto& sensors     = sensors_mng->get();
-        auto        sensors_obj = json::CreateObject();
-        if (sensors.bme280) {
-            AddFormatedToObject(sensors_obj, "temperature", "%.2f", sensors.bme280->temperature);
-            AddFormatedToObject(sensors_obj, "humidity", "%.2f", sensors.bme280->humidity);
-            AddFormatedToObject(sensors_obj, "pressure", "%.2f", sensors.bme280->pressure);
+    xEventGroupWaitBits(app_main_event_group, SENSORS_DONE, pdFALSE, pdTRUE, remaining(deadline));
+    const auto& result = sensors_mng->get();
+    if (upload || report::changed(result)) {
+        batch::push(result);
+        if (!upload && upload_predicted) {
+            upload = true;
+            provision_main();
         }
-        const std::string topic = std::string(CONFIG_MQTT_TOPIC_SENSORS) + "/" + utils::get_mac();
-        mqtt_mng->publish(topic.c_str(), PrintUnformatted(sensors_obj));
-
-        ESP_LOGI(TAG, "flush %d", mqtt_mng->flush(5s));
+    }
+    auto cycle = deepsleep::cycle_e::IDLE;
+    if (!upload) {
+        ESP_LOGI(TAG, "batched %d", batch::size());
     } else {
-        ESP_LOGW(TAG, "no MQTT_CONNECTED_EVENT");
+        const auto uxBits = xEventGroupWaitBits(
+            app_main_event_group, MQTT_CREATED | MQTT_CONNECTED_EVENT, pdFALSE, pdTRUE, remaining(deadline));
+        blink::set(blink::led_state_e::ON);
+        ESP_LOGI(TAG, "wrapping");
+        cycle = deepsleep::cycle_e::FAILURE;
+        if ((uxBits & (MQTT_CREATED | MQTT_CONNECTED_EVENT)) == (MQTT_CREATED | MQTT_CONNECTED_EVENT)) {
+            const bool published = publish_batch();
+            const bool flushed   = mqtt_mng->flush(5s);
+            ESP_LOGI(TAG, "flush %d", flushed);
+            if (published && flushed) {
+                cycle = deepsleep::cycle_e::SUCCESS;
+                state::published();
+            }
+        } else {
+            ESP_LOGW(TAG, "no MQTT_CONNECTED_EVENT");
+            ip_lease_invalidate();
+        }
     }
     //  mqtt_mng.reset();some error
     sensors_mng.reset();
     blink::set(blink::led_state_e::OFF);
-    deepsleep::deep_sleep(std::chrono::seconds(CONFIG_POOL_INTERVAL_DEFAULT));
+    timekeeping::finish();
+    timing::finish();
+    power::finish();
+    diag::finish();
+    const auto interval = deepsleep::next_interval(cycle);
+    wake_stub::arm(interval);
+    deepsleep::deep_sleep(interval);
 }
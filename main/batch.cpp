@@ -0,0 +1,67 @@
+/*
+ * batch.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "batch.hpp"
+#include <algorithm>
+#include "deepsleep.hpp"
+#include "timekeeping.hpp"
+#include "utils.hpp"
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "sdkconfig.h"
+
+namespace batch {
+static const char* TAG = "BATCH";
+
+RTC_DATA_ATTR utils::ring_buffer<sample_t, CONFIG_BATCH_CAPACITY> samples;
+RTC_DATA_ATTR int wakes_since_upload = 0;
+
+bool upload_due() {
+    const bool due = deepsleep::is_cold_boot() || (wakes_since_upload + 1 >= CONFIG_BATCH_UPLOAD_WAKES)
+                  || (samples.size() + 1 >= samples.capacity());
+    ESP_LOGI(TAG, "samples=%d, wakes since upload=%d, upload %s", samples.size(), wakes_since_upload,
+        due ? "due" : "postponed");
+    return due;
+}
+
+int wakes_until_due() {
+    const int res = std::min<int>(CONFIG_BATCH_UPLOAD_WAKES - 1 - wakes_since_upload,
+        samples.capacity() - 1 - samples.size());
+    return std::max(res, 0);
+}
+
+void push(const sensors::result_t& result, int boot_count, std::chrono::microseconds age) {
+    wakes_since_upload++;
+    const int64_t now = timekeeping::now_us();
+    samples.push({ .boot_count = boot_count,
+        .time                  = now ? static_cast<uint32_t>((now - age.count()) / 1000000) : 0,
+        .result                = result });
+}
+
+size_t size() {
+    return samples.size();
+}
+
+const sample_t& at(size_t idx) {
+    return samples[idx];
+}
+
+const sample_t& latest() {
+    return samples.back();
+}
+
+void uploaded(size_t count) {
+    ESP_LOGI(TAG, "uploaded %d of %d samples", count, samples.size());
+    for (size_t i = 0; i < count; i++) {
+        samples.pop();
+    }
+    if (samples.empty()) {
+        wakes_since_upload = 0;
+    }
+}
+
+} // namespace batch
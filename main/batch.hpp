@@ -0,0 +1,38 @@
+/*
+ * batch.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include "collector.hpp"
+#include "deepsleep.hpp"
+
+namespace batch {
+
+typedef struct {
+    int               boot_count;
+    uint32_t          time; // epoch, s. 0 - the clock was never synced
+    sensors::result_t result;
+} sample_t;
+
+// true when the radio must be brought up on this wake
+bool upload_due();
+// samples that can be stored on the next wakes before the upload is due
+int wakes_until_due();
+
+// boot_count and the age of a sample taken by the wake stub on an earlier wake
+void            push(const sensors::result_t& result, int boot_count = deepsleep::get_boot_count(),
+               std::chrono::microseconds age = {});
+size_t          size();
+const sample_t& at(size_t idx); // 0 - the oldest
+const sample_t& latest();
+
+// the oldest count samples were delivered, the upload is done with the last of them
+void uploaded(size_t count);
+} // namespace batch
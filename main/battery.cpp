@@ -0,0 +1,66 @@
+/*
+ * battery.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "battery.hpp"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// CONFIG_BATTERY_* are defined only for the present battery
+#if CONFIG_PRESENT_BATTERY
+namespace sensors {
+
+static const char*    TAG         = "BATTERY";
+constexpr auto        ADC_CHANNEL = static_cast<adc_channel_t>(CONFIG_BATTERY_ADC_CHANNEL);
+constexpr adc_atten_t ADC_ATTEN   = ADC_ATTEN_DB_12;
+constexpr int         SAMPLES     = 4;
+
+CBattery::CBattery(i2c_bus_handle_t& /*i2c_bus*/) {
+    const adc_oneshot_unit_init_cfg_t unit_cfg = { .unit_id = ADC_UNIT_1, .clk_src = {}, .ulp_mode = {} };
+    ESP_ERROR_CHECK(adc_oneshot_new_unit(&unit_cfg, &adc_));
+    const adc_oneshot_chan_cfg_t chan_cfg = { .atten = ADC_ATTEN, .bitwidth = ADC_BITWIDTH_DEFAULT };
+    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc_, ADC_CHANNEL, &chan_cfg));
+    const adc_cali_curve_fitting_config_t cali_cfg
+        = { .unit_id = ADC_UNIT_1, .chan = ADC_CHANNEL, .atten = ADC_ATTEN, .bitwidth = ADC_BITWIDTH_DEFAULT };
+    if (adc_cali_create_scheme_curve_fitting(&cali_cfg, &cali_) != ESP_OK) {
+        ESP_LOGW(TAG, "no calibration");
+        cali_ = nullptr;
+    }
+}
+
+CBattery::~CBattery() {
+    if (cali_) {
+        adc_cali_delete_scheme_curve_fitting(cali_);
+    }
+    adc_oneshot_del_unit(adc_);
+}
+
+std::optional<std::chrono::microseconds> CBattery::start() {
+    return std::chrono::microseconds(0);
+}
+
+std::optional<float> CBattery::read() {
+    int raw_sum = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        int raw = 0;
+        if (adc_oneshot_read(adc_, ADC_CHANNEL, &raw) != ESP_OK) {
+            ESP_LOGE(TAG, "adc_oneshot_read failed");
+            return std::nullopt;
+        }
+        raw_sum += raw;
+    }
+    int mv = raw_sum / SAMPLES;
+    if (cali_) {
+        adc_cali_raw_to_voltage(cali_, mv, &mv);
+    }
+    const float volt = mv * CONFIG_BATTERY_DIVIDER / 1000.f / 1000.f;
+    ESP_LOGD(TAG, "battery:%fV", volt);
+    return volt;
+}
+
+} // namespace sensors
+#endif
@@ -0,0 +1,37 @@
+/*
+ * battery.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_cali.h"
+#include "i2c_bus.h"
+
+namespace sensors {
+
+// battery voltage through the divider, V. the conversion is immediate, driven by utils::generic_sensor
+class CBattery {
+ public:
+    using value_t                   = float;
+    static constexpr auto RETRY_TM  = std::chrono::milliseconds(1);
+    static constexpr int  RETRY_MAX = 2;
+
+    // not on the bus, the argument keeps the drivers uniform
+    CBattery(i2c_bus_handle_t& i2c_bus);
+    ~CBattery();
+
+    std::optional<std::chrono::microseconds> start();
+    std::optional<float>                     read();
+
+ private:
+    adc_oneshot_unit_handle_t adc_  = nullptr;
+    adc_cali_handle_t         cali_ = nullptr;
+};
+
+} // namespace sensors
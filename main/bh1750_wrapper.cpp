@@ -0,0 +1,50 @@
+/*
+ * bh1750_wrapper.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "bh1750_wrapper.hpp"
+#include <mutex>
+#include "esp_log.h"
+
+namespace sensors {
+
+static const char* TAG = "BH1750";
+
+CBH1750_wrapper::CBH1750_wrapper(i2c_bus_handle_t& i2c_bus)
+    : bh1750_(bh1750_create(i2c_bus, BH1750_I2C_ADDRESS_DEFAULT))
+    , pm_lock_(ESP_PM_APB_FREQ_MAX, "i2c") {}
+
+CBH1750_wrapper::~CBH1750_wrapper() {
+    {
+        std::lock_guard<power::CLock> lock(pm_lock_);
+        bh1750_power_down(bh1750_);
+    }
+    bh1750_delete(&bh1750_);
+}
+
+std::optional<std::chrono::microseconds> CBH1750_wrapper::start() {
+    std::lock_guard<power::CLock> lock(pm_lock_);
+    bh1750_power_on(bh1750_);
+    const auto res = bh1750_set_measure_mode(bh1750_, BH1750_ONETIME_1LX_RES);
+    ESP_LOGI(TAG, "bh1750_set_measure_mode:%d", res);
+    if (res != ESP_OK) {
+        return std::nullopt;
+    }
+    return MEASUREMENT_TM;
+}
+
+std::optional<float> CBH1750_wrapper::read() {
+    std::lock_guard<power::CLock> lock(pm_lock_);
+    float                         lux;
+    if (ESP_OK != bh1750_get_data(bh1750_, &lux)) {
+        ESP_LOGI(TAG, "bh1750 not ready");
+        return std::nullopt;
+    }
+    ESP_LOGD(TAG, "light:%f", lux);
+    return lux;
+}
+
+} // namespace sensors
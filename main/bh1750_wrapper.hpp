@@ -0,0 +1,37 @@
+/*
+ * bh1750_wrapper.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include "i2c_bus.h"
+#include "bh1750.h"
+#include "power.hpp"
+
+namespace sensors {
+
+// one time high resolution measurement, lux. driven by utils::generic_sensor
+class CBH1750_wrapper {
+ public:
+    using value_t                   = float;
+    static constexpr auto RETRY_TM  = std::chrono::milliseconds(20);
+    static constexpr int  RETRY_MAX = 5;
+
+    CBH1750_wrapper(i2c_bus_handle_t& i2c_bus);
+    ~CBH1750_wrapper();
+
+    std::optional<std::chrono::microseconds> start();
+    std::optional<float>                     read();
+
+ private:
+    static constexpr auto MEASUREMENT_TM = std::chrono::milliseconds(180);
+    bh1750_handle_t       bh1750_;
+    power::CLock          pm_lock_;
+};
+
+} // namespace sensors
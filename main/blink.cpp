@@ -51,6 +51,8 @@ void init() {
     gpio_reset_pin(BLINK_GPIO);
     /* Set the GPIO as a push/pull output */
     gpio_set_direction(BLINK_GPIO, GPIO_MODE_OUTPUT);
+    /* keep the LED level through the automatic light sleep */
+    gpio_sleep_sel_dis(BLINK_GPIO);
 }
 
 void set(led_state_e state) {
@@ -0,0 +1,129 @@
+/*
+ * bme280_compensate.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "bme280_compensate.hpp"
+
+namespace sensors {
+
+static uint16_t u16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+bme280_calib_t bme280_parse_calib(const uint8_t (&tp)[BME280_CALIB_TP_SIZE], const uint8_t (&h)[BME280_CALIB_H_SIZE]) {
+    bme280_calib_t calib;
+    calib.dig_T1 = u16(&tp[0]);
+    calib.dig_T2 = static_cast<int16_t>(u16(&tp[2]));
+    calib.dig_T3 = static_cast<int16_t>(u16(&tp[4]));
+    calib.dig_P1 = u16(&tp[6]);
+    calib.dig_P2 = static_cast<int16_t>(u16(&tp[8]));
+    calib.dig_P3 = static_cast<int16_t>(u16(&tp[10]));
+    calib.dig_P4 = static_cast<int16_t>(u16(&tp[12]));
+    calib.dig_P5 = static_cast<int16_t>(u16(&tp[14]));
+    calib.dig_P6 = static_cast<int16_t>(u16(&tp[16]));
+    calib.dig_P7 = static_cast<int16_t>(u16(&tp[18]));
+    calib.dig_P8 = static_cast<int16_t>(u16(&tp[20]));
+    calib.dig_P9 = static_cast<int16_t>(u16(&tp[22]));
+    // tp[24] is reserved
+    calib.dig_H1 = tp[25];
+    calib.dig_H2 = static_cast<int16_t>(u16(&h[0]));
+    calib.dig_H3 = h[2];
+    // 12 bit signed values sharing 0xE5
+    calib.dig_H4 = static_cast<int16_t>(static_cast<int8_t>(h[3]) * 16 | (h[4] & 0x0F));
+    calib.dig_H5 = static_cast<int16_t>(static_cast<int8_t>(h[5]) * 16 | (h[4] >> 4));
+    calib.dig_H6 = static_cast<int8_t>(h[6]);
+    return calib;
+}
+
+bme280_raw_t bme280_parse_raw(const uint8_t (&data)[BME280_DATA_SIZE]) {
+    bme280_raw_t raw;
+    raw.pressure    = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4);
+    raw.temperature = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4);
+    raw.humidity    = (data[6] << 8) | data[7];
+    return raw;
+}
+
+bme280_t bme280_compensate(const bme280_calib_t& calib, const bme280_raw_t& raw) {
+    bme280_t res;
+
+    const float adc_T = raw.temperature;
+    float       var1  = (adc_T / 16384.f - calib.dig_T1 / 1024.f) * calib.dig_T2;
+    float       var2  = adc_T / 131072.f - calib.dig_T1 / 8192.f;
+    var2              = var2 * var2 * calib.dig_T3;
+    const float t_fine = var1 + var2;
+    res.temperature    = t_fine / 5120.f;
+
+    var1 = t_fine / 2.f - 64000.f;
+    var2 = var1 * var1 * calib.dig_P6 / 32768.f;
+    var2 = var2 + var1 * calib.dig_P5 * 2.f;
+    var2 = var2 / 4.f + calib.dig_P4 * 65536.f;
+    var1 = (calib.dig_P3 * var1 * var1 / 524288.f + calib.dig_P2 * var1) / 524288.f;
+    var1 = (1.f + var1 / 32768.f) * calib.dig_P1;
+    if (var1 == 0) {
+        res.pressure = 0; // avoid division by zero
+    } else {
+        float p      = 1048576.f - raw.pressure;
+        p            = (p - var2 / 4096.f) * 6250.f / var1;
+        var1         = calib.dig_P9 * p * p / 2147483648.f;
+        var2         = p * calib.dig_P8 / 32768.f;
+        p            = p + (var1 + var2 + calib.dig_P7) / 16.f;
+        res.pressure = p / 100.f;
+    }
+
+    float h = t_fine - 76800.f;
+    h       = (raw.humidity - (calib.dig_H4 * 64.f + calib.dig_H5 / 16384.f * h))
+        * (calib.dig_H2 / 65536.f * (1.f + calib.dig_H6 / 67108864.f * h * (1.f + calib.dig_H3 / 67108864.f * h)));
+    h = h * (1.f - calib.dig_H1 * h / 524288.f);
+    res.humidity = h > 100.f ? 100.f : h < 0.f ? 0.f : h;
+    return res;
+}
+
+bme280_fixed_t bme280_compensate_fixed(const bme280_calib_t& calib, const bme280_raw_t& raw) {
+    bme280_fixed_t res;
+
+    const int32_t adc_T = raw.temperature;
+    int32_t       var1  = (((adc_T >> 3) - (static_cast<int32_t>(calib.dig_T1) << 1)) * calib.dig_T2) >> 11;
+    int32_t       var2  = (adc_T >> 4) - calib.dig_T1;
+    var2                = (((var2 * var2) >> 12) * calib.dig_T3) >> 14;
+    const int32_t t_fine = var1 + var2;
+    res.temperature      = (t_fine * 5 + 128) >> 8;
+
+    int64_t p1 = static_cast<int64_t>(t_fine) - 128000;
+    int64_t p2 = p1 * p1 * calib.dig_P6;
+    p2         = p2 + ((p1 * calib.dig_P5) << 17);
+    p2         = p2 + (static_cast<int64_t>(calib.dig_P4) << 35);
+    p1         = ((p1 * p1 * calib.dig_P3) >> 8) + ((p1 * calib.dig_P2) << 12);
+    p1         = (((static_cast<int64_t>(1) << 47) + p1) * calib.dig_P1) >> 33;
+    if (p1 == 0) {
+        res.pressure = 0; // avoid division by zero
+    } else {
+        int64_t p    = 1048576 - raw.pressure;
+        p            = (((p << 31) - p2) * 3125) / p1;
+        p2           = (calib.dig_P9 * (p >> 13) * (p >> 13)) >> 25;
+        const auto p3 = (calib.dig_P8 * p) >> 19;
+        res.pressure = static_cast<uint32_t>(((p + p2 + p3) >> 8) + (static_cast<int64_t>(calib.dig_P7) << 4));
+    }
+
+    int32_t h = t_fine - 76800;
+    h = ((((raw.humidity << 14) - (static_cast<int32_t>(calib.dig_H4) << 20) - (calib.dig_H5 * h)) + 16384) >> 15)
+        * (((((((h * calib.dig_H6) >> 10) * (((h * calib.dig_H3) >> 11) + 32768)) >> 10) + 2097152) * calib.dig_H2
+               + 8192)
+            >> 14);
+    h            = h - (((((h >> 15) * (h >> 15)) >> 7) * calib.dig_H1) >> 4);
+    h            = h < 0 ? 0 : h > 419430400 ? 419430400 : h;
+    res.humidity = static_cast<uint32_t>(h >> 12);
+    return res;
+}
+
+bme280_t to_bme280(const bme280_fixed_t& fixed) {
+    bme280_t res;
+    res.temperature = fixed.temperature / 100.f;
+    res.pressure    = fixed.pressure / (256.f * 100.f);
+    res.humidity    = fixed.humidity / 1024.f;
+    return res;
+}
+
+} // namespace sensors
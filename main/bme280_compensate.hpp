@@ -0,0 +1,81 @@
+/*
+ * bme280_compensate.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sensors {
+
+typedef struct {
+    float temperature; // C
+    float humidity;    // %RH
+    float pressure;    // hPa
+} bme280_t;
+
+// trimming parameters, datasheet 4.2.2
+typedef struct {
+    uint16_t dig_T1;
+    int16_t  dig_T2;
+    int16_t  dig_T3;
+    uint16_t dig_P1;
+    int16_t  dig_P2;
+    int16_t  dig_P3;
+    int16_t  dig_P4;
+    int16_t  dig_P5;
+    int16_t  dig_P6;
+    int16_t  dig_P7;
+    int16_t  dig_P8;
+    int16_t  dig_P9;
+    uint8_t  dig_H1;
+    int16_t  dig_H2;
+    uint8_t  dig_H3;
+    int16_t  dig_H4;
+    int16_t  dig_H5;
+    int8_t   dig_H6;
+} bme280_calib_t;
+
+// uncompensated ADC output
+typedef struct {
+    int32_t temperature; // 20 bit
+    int32_t pressure;    // 20 bit
+    int32_t humidity;    // 16 bit
+} bme280_raw_t;
+
+constexpr uint8_t BME280_REG_CHIP_ID      = 0xD0;
+constexpr uint8_t BME280_CHIP_ID          = 0x60;
+constexpr uint8_t BME280_REG_CTRL_HUM     = 0xF2;
+constexpr uint8_t BME280_REG_STATUS       = 0xF3;
+constexpr uint8_t BME280_STATUS_MEASURING = 0x08; // the conversion is running, the data is of the previous one
+constexpr uint8_t BME280_REG_CTRL_MEAS    = 0xF4;
+constexpr uint8_t BME280_REG_CONFIG       = 0xF5;
+constexpr uint8_t BME280_REG_CALIB_TP     = 0x88; // 0x88..0xA1
+constexpr size_t  BME280_CALIB_TP_SIZE    = 26;
+constexpr uint8_t BME280_REG_CALIB_H      = 0xE1; // 0xE1..0xE7
+constexpr size_t  BME280_CALIB_H_SIZE     = 7;
+constexpr uint8_t BME280_REG_DATA         = 0xF7; // press_msb..hum_lsb, 0xF7..0xFE
+constexpr size_t  BME280_DATA_SIZE        = 8;
+// data register value of a skipped or not yet completed conversion
+constexpr int32_t BME280_ADC_SKIPPED      = 0x80000;
+
+// fixed-point output of the datasheet 4.2.3 int32/int64 algorithms
+typedef struct {
+    int32_t  temperature; // 0.01 C
+    uint32_t pressure;    // Q24.8 Pa
+    uint32_t humidity;    // Q22.10 %RH
+} bme280_fixed_t;
+
+bme280_calib_t bme280_parse_calib(const uint8_t (&tp)[BME280_CALIB_TP_SIZE], const uint8_t (&h)[BME280_CALIB_H_SIZE]);
+bme280_raw_t   bme280_parse_raw(const uint8_t (&data)[BME280_DATA_SIZE]);
+// datasheet 8.1, all three values in one pass sharing t_fine
+bme280_t bme280_compensate(const bme280_calib_t& calib, const bme280_raw_t& raw);
+// integer only, no soft-float on the way, see CONFIG_BME280_COMPENSATION_FIXED
+bme280_fixed_t bme280_compensate_fixed(const bme280_calib_t& calib, const bme280_raw_t& raw);
+bme280_t       to_bme280(const bme280_fixed_t& fixed);
+
+} // namespace sensors
@@ -9,8 +9,10 @@
 #include "sdkconfig.h"
 
 #include <memory>
+#include <mutex>
 #include <stdio.h>
 #include <utility>
+#include "esp_attr.h"
 #include "esp_log.h"
 
 using namespace std::chrono_literals;
@@ -19,66 +21,163 @@ namespace sensors {
 
 static const char* TAG = "BME280";
 
-void CBME260_wrapper::read() {
-    bme280_t data;
-    if (ESP_OK == bme280_read_temperature(bme280_id, &data.temperature)) {
-        ESP_LOGD(TAG, "temperature:%f ", data.temperature);
-        if (ESP_OK == bme280_read_humidity(bme280_id, &data.humidity)) {
-            ESP_LOGD(TAG, "humidity:%f ", data.humidity);
-            if (ESP_OK == bme280_read_pressure(bme280_id, &data.pressure)) {
-                ESP_LOGD(TAG, "pressure:%f\n", data.pressure);
-                retry_tm_.reset();
-                cb_(std::move(data));
-                return;
-            }
-        }
-    }
-    ESP_LOGI(TAG, "bme280_retry");
-    if (!retry_tm_) {
-        retry_tm_ = std::make_unique<idf::esp_timer::ESPTimer>([this]() { read(); });
-    }
-    retry_tm_->start(BME280_RETRY_TM);
+bme280_profile_t bme280_profile() {
+#if CONFIG_BME280_PROFILE_FAST
+    return { BME280_SAMPLING_X1, BME280_SAMPLING_X1, BME280_SAMPLING_X1 };
+#else
+    return { BME280_SAMPLING_X16, BME280_SAMPLING_X16, BME280_SAMPLING_X16 };
+#endif
 }
 
-CBME260_wrapper::CBME260_wrapper(i2c_bus_handle_t& i2c_bus) {
-    bme280_id = bme280_create(i2c_bus, BME280_I2C_ADDRESS_DEFAULT);
+static unsigned oversampling(bme280_sampling sampling) {
+    return sampling == BME280_SAMPLING_NONE ? 0 : 1u << (static_cast<unsigned>(sampling) - 1);
 }
-CBME260_wrapper::~CBME260_wrapper() {
-    bme280_delete(&bme280_id);
+
+std::chrono::microseconds measurement_time(const bme280_profile_t& profile) {
+    // datasheet 9.1: 1.25 + 2.3 * T + (2.3 * P + 0.575) + (2.3 * H + 0.575) ms
+    std::chrono::microseconds res(1250 + 2300 * oversampling(profile.temperature));
+    if (profile.pressure != BME280_SAMPLING_NONE) {
+        res += std::chrono::microseconds(2300 * oversampling(profile.pressure) + 575);
+    }
+    if (profile.humidity != BME280_SAMPLING_NONE) {
+        res += std::chrono::microseconds(2300 * oversampling(profile.humidity) + 575);
+    }
+    return res;
 }
 
-void CBME260_wrapper::set_mode(bme280_sensor_mode mode) {
-    const auto res = bme280_set_sampling(bme280_id, mode, BME280_SAMPLING_X16, BME280_SAMPLING_X16, BME280_SAMPLING_X16,
-        BME280_FILTER_OFF, BME280_STANDBY_MS_0_5);
-    if (res != ESP_OK) {
-        ESP_LOGE(TAG, "bme280_set_mode %d, result=%d", static_cast<int>(mode), static_cast<int>(res));
+// chip_id is 0 until the calibration is read
+typedef struct {
+    uint8_t        chip_id;
+    bme280_calib_t calib;
+} calib_cache_t;
+
+static RTC_DATA_ATTR calib_cache_t calib_cache;
+// of the last successful read, the wake stub reference
+static RTC_DATA_ATTR bool         last_raw_valid;
+static RTC_DATA_ATTR bme280_raw_t last_raw;
+
+bool bme280_cached_calibration(bme280_calib_t& calib) {
+    if (!calib_cache.chip_id) {
+        return false;
     }
+    calib = calib_cache.calib;
+    return true;
 }
-void CBME260_wrapper::init() {
-    const auto res = bme280_default_init(bme280_id);
-    ESP_LOGI(TAG, "bme280_default_init:%d", res);
+
+bool bme280_last_raw(bme280_raw_t& raw) {
+    raw = last_raw;
+    return last_raw_valid;
 }
 
-void CBME260_wrapper::begin(cb_t&& cb) {
-    cb_ = std::move(cb);
-    read();
+bme280_t bme280_convert(const bme280_calib_t& calib, const bme280_raw_t& raw) {
+#if CONFIG_BME280_COMPENSATION_FLOAT
+    return bme280_compensate(calib, raw);
+#else
+    return to_bme280(bme280_compensate_fixed(calib, raw));
+#endif
 }
-esp_err_t CBME260_wrapper::take_forced_measurement() {
-    return bme280_take_forced_measurement(bme280_id);
+
+uint8_t bme280_ctrl_meas(const bme280_profile_t& profile, bme280_sensor_mode mode) {
+    return (profile.temperature << 5) | (profile.pressure << 2) | mode;
 }
 
-CBME260_wrapper_forced::CBME260_wrapper_forced(i2c_bus_handle_t& i2c_bus, cb_t&& cb)
-    : generic_sensor<bme280_t>(std::move(cb))
-    , bme_(i2c_bus) {
-    bme_.init();
-    bme_.set_mode(BME280_MODE_FORCED);
-    bme_.begin([this](auto res) { set(res); });
+std::optional<bme280_t> CBME260_wrapper::read() {
+    std::lock_guard<power::CLock> lock(pm_lock_);
+    // powered across the deep sleep, the data registers hold the previous wake sample until the conversion ends
+    uint8_t status = 0;
+    if (ESP_OK != i2c_bus_read_byte(dev_, BME280_REG_STATUS, &status)) {
+        ESP_LOGE(TAG, "bme280 status failed");
+        return std::nullopt;
+    }
+    if (status & BME280_STATUS_MEASURING) {
+        ESP_LOGI(TAG, "bme280 measuring");
+        return std::nullopt;
+    }
+    uint8_t data[BME280_DATA_SIZE];
+    if (ESP_OK != i2c_bus_read_bytes(dev_, BME280_REG_DATA, sizeof(data), data)) {
+        ESP_LOGE(TAG, "bme280_read failed");
+        return std::nullopt;
+    }
+    const auto raw = bme280_parse_raw(data);
+    if (raw.temperature == BME280_ADC_SKIPPED) {
+        ESP_LOGI(TAG, "bme280 not ready");
+        return std::nullopt;
+    }
+    last_raw_valid = true;
+    last_raw       = raw;
+    const auto res = bme280_convert(calib_, raw);
+    ESP_LOGD(TAG, "temperature:%f humidity:%f pressure:%f", res.temperature, res.humidity, res.pressure);
+    return res;
+}
 
-    ESP_LOGI(TAG, "bme280_take_forced_measurement:%d", bme_.take_forced_measurement());
+esp_err_t CBME260_wrapper::load_calibration() {
+    uint8_t chip_id = 0;
+    auto    res     = i2c_bus_read_byte(dev_, BME280_REG_CHIP_ID, &chip_id);
+    if (res != ESP_OK) {
+        return res;
+    }
+    if (chip_id != BME280_CHIP_ID) {
+        ESP_LOGE(TAG, "unexpected chip id 0x%02x", chip_id);
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (calib_cache.chip_id == chip_id) {
+        calib_ = calib_cache.calib;
+        return ESP_OK;
+    }
+    uint8_t tp[BME280_CALIB_TP_SIZE];
+    uint8_t h[BME280_CALIB_H_SIZE];
+    res = i2c_bus_read_bytes(dev_, BME280_REG_CALIB_TP, sizeof(tp), tp);
+    if (res == ESP_OK) {
+        res = i2c_bus_read_bytes(dev_, BME280_REG_CALIB_H, sizeof(h), h);
+    }
+    if (res != ESP_OK) {
+        return res;
+    }
+    calib_ = bme280_parse_calib(tp, h);
+    // the sensor has been power cycled as well, filter off, standby unused in forced mode
+    res = i2c_bus_write_byte(dev_, BME280_REG_CONFIG, 0);
+    if (res == ESP_OK) {
+        calib_cache = { chip_id, calib_ };
+        ESP_LOGI(TAG, "calibration cached");
+    }
+    return res;
+}
+
+CBME260_wrapper::CBME260_wrapper(i2c_bus_handle_t& i2c_bus)
+    : dev_(i2c_bus_device_create(i2c_bus, BME280_I2C_ADDRESS_DEFAULT, 0))
+    , calib_()
+    , profile_(bme280_profile())
+    , pm_lock_(ESP_PM_APB_FREQ_MAX, "i2c") {}
+CBME260_wrapper::~CBME260_wrapper() {
+    {
+        std::lock_guard<power::CLock> lock(pm_lock_);
+        set_mode(BME280_MODE_SLEEP);
+    }
+    i2c_bus_device_delete(&dev_);
 }
 
-CBME260_wrapper_forced::~CBME260_wrapper_forced() {
-    bme_.set_mode(BME280_MODE_SLEEP);
+// ctrl_hum takes effect after the ctrl_meas write
+void CBME260_wrapper::set_mode(bme280_sensor_mode mode) {
+    auto res = i2c_bus_write_byte(dev_, BME280_REG_CTRL_HUM, profile_.humidity);
+    if (res == ESP_OK) {
+        res = i2c_bus_write_byte(dev_, BME280_REG_CTRL_MEAS, bme280_ctrl_meas(profile_, mode));
+    }
+    if (res != ESP_OK) {
+        ESP_LOGE(TAG, "bme280_set_mode %d, result=%d", static_cast<int>(mode), static_cast<int>(res));
+    }
+}
+
+std::optional<std::chrono::microseconds> CBME260_wrapper::start() {
+    std::lock_guard<power::CLock> lock(pm_lock_);
+    const auto                    res = load_calibration();
+    ESP_LOGI(TAG, "bme280 init:%d", res);
+    if (res != ESP_OK) {
+        return std::nullopt; // reported as a failure at once, the collector does not wait for it
+    }
+    set_mode(BME280_MODE_FORCED);
+    const auto delay = measurement_time(profile_);
+    ESP_LOGD(TAG, "read in %lldus", delay.count());
+    return delay;
 }
 
 } // namespace sensors
@@ -7,53 +7,60 @@
 
 #pragma once
 
-#include <functional>
-#include <memory>
 #include <stdint.h>
 #include <chrono>
+#include <optional>
 #include "driver/i2c.h"
 #include "esp_err.h"
 #include "i2c_bus.h"
-#include "utils.hpp"
 #include "bme280.h"
-#include "esp_timer_cxx.hpp"
+#include "bme280_compensate.hpp"
+#include "power.hpp"
 
 namespace sensors {
 
 typedef struct {
-    float temperature;
-    float humidity;
-    float pressure;
-} bme280_t;
+    bme280_sampling temperature;
+    bme280_sampling pressure;
+    bme280_sampling humidity;
+} bme280_profile_t;
 
-class CBME260_wrapper {
- protected:
-    using cb_t                                                = std::function<void(const bme280_t&&)>;
-    static constexpr auto                     BME280_RETRY_TM = std::chrono::milliseconds(100);
-    bme280_handle_t                           bme280_id;
-    std::unique_ptr<idf::esp_timer::ESPTimer> retry_tm_;
-    cb_t                                      cb_;
-
-    void read();
+// measurement profile selected by CONFIG_BME280_PROFILE_*
+bme280_profile_t bme280_profile();
+// datasheet t_measure,max for the oversampling settings
+std::chrono::microseconds measurement_time(const bme280_profile_t& profile);
+uint8_t                   bme280_ctrl_meas(const bme280_profile_t& profile, bme280_sensor_mode mode);
+// the trimming parameters cached in RTC memory, false until read once
+bool bme280_cached_calibration(bme280_calib_t& calib);
+// the raw sample of the last successful read
+bool bme280_last_raw(bme280_raw_t& raw);
+// the compensation selected by CONFIG_BME280_COMPENSATION_*
+bme280_t bme280_convert(const bme280_calib_t& calib, const bme280_raw_t& raw);
 
+// forced mode measurement, driven by utils::generic_sensor
+class CBME260_wrapper {
  public:
+    using value_t                  = bme280_t;
+    static constexpr auto RETRY_TM  = std::chrono::milliseconds(5);
+    static constexpr int  RETRY_MAX = 10;
+
     CBME260_wrapper(i2c_bus_handle_t& i2c_bus);
     ~CBME260_wrapper();
 
-    void set_mode(bme280_sensor_mode mode);
-    void init();
+    // the forced mode write starts the conversion, the read is due when it is expected to be completed
+    std::optional<std::chrono::microseconds> start();
+    // all the data registers in one burst, compensated in one pass
+    std::optional<bme280_t> read();
 
-    void      begin(cb_t&& cb);
-    esp_err_t take_forced_measurement();
-};
-
-class CBME260_wrapper_forced: private utils::generic_sensor<bme280_t> {
  private:
-    CBME260_wrapper bme_;
+    i2c_bus_device_handle_t dev_;
+    bme280_calib_t          calib_;
+    bme280_profile_t        profile_;
+    power::CLock            pm_lock_; // APB clock for the I2C transfers
 
- public:
-    CBME260_wrapper_forced(i2c_bus_handle_t& i2c_bus, cb_t&& cb);
-    ~CBME260_wrapper_forced();
+    void set_mode(bme280_sensor_mode mode);
+    // the trimming parameters survive deep sleep in RTC memory, guarded by the chip ID
+    esp_err_t load_calibration();
 };
 
 } // namespace sensors
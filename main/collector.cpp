@@ -8,9 +8,7 @@
 #include "lwip/sys.h"
 #include "sdkconfig.h"
 
-#include <memory>
 #include <stdio.h>
-#include <utility>
 #include "esp_log.h"
 
 namespace sensors {
@@ -21,8 +19,7 @@ namespace sensors {
 #define I2C_MASTER_FREQ_HZ 100000 /*!< I2C master clock frequency */
 static const char* TAG = "SENSORS";
 
-CCollector::CCollector(cb_t&& cb)
-    : cb_(std::move(cb)) {
+CCollectorBase::CCollectorBase() {
     ESP_LOGI(TAG, "CManager::Impl created");
     ESP_LOGD(TAG, "i2c_master_scl_io:%d i2c_master_sda_io:%d", CONFIG_I2C_MASTER_SCL_IO, CONFIG_I2C_MASTER_SDA_IO);
     i2c_config_t conf = {
@@ -35,35 +32,40 @@ CCollector::CCollector(cb_t&& cb)
         .clk_flags     = {},
     };
     i2c_bus = i2c_bus_create(I2C_MASTER_NUM, &conf);
-    if (CONFIG_PRESENT_BME280) {
-        bme280_ = std::make_unique<CBME260_wrapper_forced>(i2c_bus, [this](auto res) {
-            result_.bme280 = res;
-            updated();
-        });
-    }
 }
-CCollector::~CCollector() {
+CCollectorBase::~CCollectorBase() {
     ESP_LOGI(TAG, "CManager::Impl deleted");
-    bme280_.reset();
     i2c_bus_delete(&i2c_bus);
 }
 
-const result_t& CCollector::get() const {
+const result_t& CCollectorBase::get() const {
     return result_;
 }
 
-bool CCollector::ready() const {
-    if (CONFIG_PRESENT_BME280 && !result_.bme280) {
+bool CCollectorBase::ready() const {
+    return pending_ == 0;
+}
+
+bool CCollectorBase::completed() {
+    if (starting_ || done_ || !ready()) {
         return false;
     }
+    done_ = true;
+    ESP_LOGI(TAG, "CManager call cb_");
     return true;
 }
 
-void CCollector::updated() {
-    if (ready()) {
-        ESP_LOGI(TAG, "CManager call cb_");
-        cb_(result_);
+void CCollectorBase::failed() {
+    ESP_LOGW(TAG, "sensor failed, %u sensors pending", static_cast<unsigned>(pending_ - 1));
+}
+
+bool CCollectorBase::timed_out() {
+    if (done_) {
+        return false;
     }
+    done_ = true;
+    ESP_LOGW(TAG, "collection timeout, %u sensors missing", static_cast<unsigned>(pending_));
+    return true;
 }
 
 } // namespace sensors
@@ -7,36 +7,169 @@
 
 #pragma once
 
-#include <functional>
-#include <memory>
+#include <mutex>
 #include <stdint.h>
 #include <optional>
 #include <chrono>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include "driver/i2c.h"
 #include "i2c_bus.h"
+#include "sdkconfig.h"
+#include "utils.hpp"
 #include <bme280_wrapper.hpp>
+#include <sht3x_wrapper.hpp>
+#include <bh1750_wrapper.hpp>
+#include <battery.hpp>
 
 namespace sensors {
 
 typedef struct {
     std::optional<bme280_t> bme280;
+    std::optional<sht3x_t>  sht3x;
+    std::optional<float>    light;   // lux
+    std::optional<float>    battery; // V
 } result_t;
 
-class CCollector {
+// a Device filling the result field, not even instantiated when not Present
+template<typename Device, auto Field, bool Present>
+struct slot {
+    using device_t                = Device;
+    static constexpr auto field   = Field;
+    static constexpr bool present = Present;
+};
+
+// the bus and the completion state shared by all the compositions
+class CCollectorBase {
  public:
-    using cb_t = std::function<void(const result_t&)>;
-    CCollector(cb_t&& cb);
-    ~CCollector();
     const result_t& get() const;
     bool            ready() const;
 
+ protected:
+    result_t         result_;
+    std::mutex       mutex_;
+    i2c_bus_handle_t i2c_bus;
+    size_t           pending_  = 0;
+    bool             starting_ = true;
+    bool             done_     = false;
+
+    CCollectorBase();
+    ~CCollectorBase();
+    // mutex_ is held by the caller, true when the collection has just been completed
+    bool completed();
+    void failed();
+    bool timed_out();
+};
+
+/*
+ * the present Slots are started at once on the shared bus.
+ * cb is called when all of them have reported, a value or a failure, or on CONFIG_SENSORS_COLLECTION_TIMEOUT
+ * with the partial result, whichever comes first.
+ * composed at compile time, the sensors are called and call back directly, no std::function or make_unique.
+ * the esp_timer of each sensor and of the timeout, the i2c_bus handles are allocated by IDF
+ */
+template<typename Cb, typename... Slots>
+class CCollector: public CCollectorBase {
+ public:
+    CCollector(Cb cb)
+        : cb_(cb)
+        , timeout_(this, "collector") {
+        timeout_.start(std::chrono::seconds(CONFIG_SENSORS_COLLECTION_TIMEOUT));
+        start(std::index_sequence_for<Slots...>());
+        // a sensor may have reported while the others were being started
+        std::lock_guard<std::mutex> lock(mutex_);
+        starting_ = false;
+        if (completed()) {
+            cb_(result_);
+        }
+    }
+    CCollector(const CCollector&)            = delete;
+    CCollector& operator=(const CCollector&) = delete;
+
  private:
-    result_t                                result_;
-    cb_t                                    cb_;
-    i2c_bus_handle_t                        i2c_bus;
-    std::unique_ptr<CBME260_wrapper_forced> bme280_;
+    template<typename Slot>
+    struct sink {
+        CCollector* self;
+        void        operator()(const std::optional<typename Slot::device_t::value_t>& val) const {
+            self->store(Slot::field, val);
+        }
+    };
+    template<typename Slot>
+    using sensor_t = std::conditional_t<Slot::present,
+        std::optional<utils::generic_sensor<typename Slot::device_t, sink<Slot>>>, std::monostate>;
+
+    void on_timeout() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timed_out()) {
+            cb_(result_);
+        }
+    }
 
-    void updated();
+    Cb cb_;
+    // destroyed in reverse, the timeout first, the bus of the base last
+    std::tuple<sensor_t<Slots>...>                           sensors_;
+    utils::member_timer<CCollector, &CCollector::on_timeout> timeout_;
+
+    template<size_t... I>
+    void start(std::index_sequence<I...>) {
+        (add<I>(), ...);
+    }
+    template<size_t I>
+    void add() {
+        using Slot = std::tuple_element_t<I, std::tuple<Slots...>>;
+        if constexpr (Slot::present) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_++;
+            }
+            std::get<I>(sensors_).emplace(i2c_bus, sink<Slot>{ this });
+        }
+    }
+    // nullopt - the sensor failed, it is not waited for
+    template<typename T>
+    void store(std::optional<T> result_t::*field, const std::optional<T>& val) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (done_ || result_.*field) {
+            return;
+        }
+        if (!val) {
+            failed();
+        }
+        result_.*field = val;
+        pending_--;
+        if (completed()) {
+            cb_(result_);
+        }
+    }
 };
 
+#if CONFIG_PRESENT_BME280
+constexpr bool PRESENT_BME280 = true;
+#else
+constexpr bool PRESENT_BME280 = false;
+#endif
+#if CONFIG_PRESENT_SHT3X
+constexpr bool PRESENT_SHT3X = true;
+#else
+constexpr bool PRESENT_SHT3X = false;
+#endif
+#if CONFIG_PRESENT_BH1750
+constexpr bool PRESENT_BH1750 = true;
+#else
+constexpr bool PRESENT_BH1750 = false;
+#endif
+#if CONFIG_PRESENT_BATTERY
+constexpr bool PRESENT_BATTERY = true;
+#else
+constexpr bool PRESENT_BATTERY = false;
+#endif
+
+// the board sensors selected by CONFIG_PRESENT_*
+template<typename Cb>
+using collector_t = CCollector<Cb, slot<CBME260_wrapper, &result_t::bme280, PRESENT_BME280>,
+    slot<CSHT3x_wrapper, &result_t::sht3x, PRESENT_SHT3X>, slot<CBH1750_wrapper, &result_t::light, PRESENT_BH1750>,
+    slot<CBattery, &result_t::battery, PRESENT_BATTERY>>;
+
 } // namespace sensors
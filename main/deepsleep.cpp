@@ -1,18 +1,46 @@
 #include "deepsleep.hpp"
+#include <algorithm>
 #include "esp_log.h"
 #include "esp_sleep.h"
 #include "sdkconfig.h"
+#include "wake_stub.hpp"
 #include <bits/chrono.h>
 
 namespace deepsleep {
 static const char* TAG = "SLEEP";
 
 RTC_DATA_ATTR int bootCount = 0;
+RTC_DATA_ATTR int failures  = 0;
 
 int get_boot_count() {
     return bootCount;
 }
 
+bool is_cold_boot() {
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+std::chrono::seconds next_interval(cycle_e cycle) {
+    switch (cycle) {
+        case cycle_e::IDLE:
+            break;
+        case cycle_e::SUCCESS:
+            failures = 0;
+            break;
+        case cycle_e::FAILURE:
+            failures++;
+            break;
+    }
+    if (!failures) {
+        return std::chrono::seconds(CONFIG_POOL_INTERVAL_DEFAULT);
+    }
+    const int  shift    = std::min(failures - 1, 16);
+    const auto interval = std::min<long long>(static_cast<long long>(CONFIG_POOL_INTERVAL_RETRY) << shift,
+        CONFIG_POOL_INTERVAL_RETRY_MAX);
+    ESP_LOGW(TAG, "failures %d, retry in %llds", failures, interval);
+    return std::chrono::seconds(interval);
+}
+
 void deep_sleep(const std::chrono::microseconds duration) {
     ESP_LOGI(TAG, "boot count %d, sleep for %lldms", get_boot_count(),
         std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
@@ -23,4 +51,9 @@ void deep_sleep(const std::chrono::microseconds duration) {
 void RTC_IRAM_ATTR esp_wake_deep_sleep() {
     esp_default_wake_deep_sleep();
     deepsleep::bootCount++;
+#if CONFIG_WAKE_STUB_PRESCREEN
+    if (wake_stub::run(deepsleep::bootCount)) {
+        wake_stub::sleep();
+    }
+#endif
 }
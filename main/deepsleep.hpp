@@ -8,6 +8,17 @@
 #include <chrono>
 namespace deepsleep {
 int get_boot_count();
+// power on or reset, not a wake up from the deep sleep
+bool is_cold_boot();
+
+enum class cycle_e {
+    IDLE,    // no upload attempted
+    SUCCESS, // the upload was acknowledged
+    FAILURE, // AP, broker or the ack did not come
+};
+// CONFIG_POOL_INTERVAL_DEFAULT, after a failure CONFIG_POOL_INTERVAL_RETRY doubled for each
+// consecutive one up to CONFIG_POOL_INTERVAL_RETRY_MAX
+std::chrono::seconds next_interval(cycle_e cycle);
 
 void deep_sleep(const std::chrono::microseconds duration);
 } // namespace deepsleep
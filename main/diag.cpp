@@ -0,0 +1,97 @@
+/*
+ * diag.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "diag.hpp"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+namespace diag {
+
+constexpr size_t PHASES_NUM = static_cast<size_t>(timing::phase_e::DEEP_SLEEP) + 1;
+constexpr size_t TASKS_NUM  = 4;
+
+// FreeRTOS task names and their names in the telemetry
+static const char* const task_names[TASKS_NUM] = { "main", "mqtt_task", "esp_timer", "sys_evt" };
+static const char* const task_keys[TASKS_NUM]  = { "main", "mqtt", "timer", "event" };
+
+typedef struct {
+    uint32_t free;
+    uint32_t min_free;
+    uint32_t largest;
+} heap_t;
+
+typedef struct {
+    bool     valid;
+    heap_t   heap[PHASES_NUM]; // free == 0 - not reached
+    uint32_t stack[TASKS_NUM]; // the lowest high-water mark seen, bytes. 0 - not seen
+} cycle_t;
+
+static cycle_t               current;
+static RTC_DATA_ATTR cycle_t previous;
+// wake cycles since the block was published
+static RTC_DATA_ATTR uint32_t cycles;
+
+void sample(timing::phase_e phase) {
+    if (!CONFIG_DIAG_INTERVAL) {
+        return;
+    }
+    auto& heap    = current.heap[static_cast<size_t>(phase)];
+    heap.free     = esp_get_free_heap_size();
+    heap.min_free = esp_get_minimum_free_heap_size();
+    heap.largest  = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+    for (size_t i = 0; i < TASKS_NUM; i++) {
+        // looked up every time, the mqtt task comes and goes with the client
+        const auto task = xTaskGetHandle(task_names[i]);
+        if (task) {
+            current.stack[i] = uxTaskGetStackHighWaterMark(task);
+        }
+    }
+}
+
+void finish() {
+    current.valid = true;
+    previous      = current;
+    cycles++;
+}
+
+void add_previous(json::Writer& out, const char* const name) {
+    if (!CONFIG_DIAG_INTERVAL || !previous.valid || cycles < CONFIG_DIAG_INTERVAL) {
+        return;
+    }
+    out.begin_object(name);
+    out.begin_object("heap");
+    for (size_t i = 0; i < PHASES_NUM; i++) {
+        const auto& heap = previous.heap[i];
+        if (heap.free) {
+            out.begin_array(timing::phase_name(static_cast<timing::phase_e>(i)))
+                .add(nullptr, heap.free)
+                .add(nullptr, heap.min_free)
+                .add(nullptr, heap.largest)
+                .end_array();
+        }
+    }
+    out.end_object();
+    out.begin_object("stack");
+    for (size_t i = 0; i < TASKS_NUM; i++) {
+        if (previous.stack[i]) {
+            out.add(task_keys[i], previous.stack[i]);
+        }
+    }
+    out.end_object();
+    out.end_object();
+}
+
+void published() {
+    if (cycles >= CONFIG_DIAG_INTERVAL) {
+        cycles = 0;
+    }
+}
+
+} // namespace diag
@@ -0,0 +1,22 @@
+/*
+ * diag.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "json_helper.hpp"
+#include "timing.hpp"
+
+namespace diag {
+// heap state and stack high-water marks at the phase boundary, called by timing::mark
+void sample(timing::phase_e phase);
+// keeps the cycle in RTC memory for the next wake
+void finish();
+// the previous wake cycle, at most once per CONFIG_DIAG_INTERVAL wakes
+void add_previous(json::Writer& out, const char* const name);
+// the block has been delivered
+void published();
+} // namespace diag
@@ -0,0 +1,82 @@
+/*
+ * ip_lease.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+#include <esp_attr.h>
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+
+#include "sdkconfig.h"
+#include "ip_lease.h"
+
+static const char* TAG = "IP_LEASE";
+
+typedef struct {
+    bool                 valid;
+    esp_netif_ip_info_t  ip_info;
+    esp_netif_dns_info_t dns;
+    time_t               obtained; /* system time survives the deep sleep */
+    uint32_t             renew;    /* T1, sec */
+} ip_lease_t;
+
+static RTC_DATA_ATTR ip_lease_t lease;
+static bool                     lease_applied;
+
+void ip_lease_apply(esp_netif_t* netif) {
+#ifdef CONFIG_IP_LEASE_REUSE
+    const time_t now = time(NULL);
+    if (!lease.valid) {
+        return;
+    }
+    if (now < lease.obtained || now - lease.obtained >= lease.renew) {
+        ESP_LOGI(TAG, "lease is due for renew");
+        lease.valid = false;
+        return;
+    }
+    if (esp_netif_dhcpc_stop(netif) != ESP_OK || esp_netif_set_ip_info(netif, &lease.ip_info) != ESP_OK) {
+        ESP_LOGW(TAG, "static config failed");
+        esp_netif_dhcpc_start(netif);
+        return;
+    }
+    esp_netif_set_dns_info(netif, ESP_NETIF_DNS_MAIN, &lease.dns);
+    lease_applied = true;
+    ESP_LOGI(TAG, "reuse " IPSTR ", renew in %" PRIu32 "s", IP2STR(&lease.ip_info.ip),
+        lease.renew - (uint32_t)(now - lease.obtained));
+#endif
+}
+
+void ip_lease_store(const ip_event_got_ip_t* event) {
+#ifdef CONFIG_IP_LEASE_REUSE
+    if (lease_applied) {
+        return;
+    }
+    const struct dhcp* dhcp = netif_dhcp_data((struct netif*)esp_netif_get_netif_impl(event->esp_netif));
+    if (!dhcp || !dhcp->offered_t1_renew) {
+        return;
+    }
+    lease.ip_info  = event->ip_info;
+    lease.renew    = dhcp->offered_t1_renew;
+    lease.obtained = time(NULL);
+    if (esp_netif_get_dns_info(event->esp_netif, ESP_NETIF_DNS_MAIN, &lease.dns) != ESP_OK) {
+        memset(&lease.dns, 0, sizeof(lease.dns));
+    }
+    lease.valid = true;
+    ESP_LOGI(TAG, "stored " IPSTR ", renew in %" PRIu32 "s", IP2STR(&lease.ip_info.ip), lease.renew);
+#endif
+}
+
+void ip_lease_invalidate(void) {
+    if (lease.valid) {
+        ESP_LOGW(TAG, "invalidated");
+    }
+    lease.valid = false;
+}
@@ -0,0 +1,25 @@
+/*
+ * ip_lease.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#ifndef MAIN_IP_LEASE_H_
+#define MAIN_IP_LEASE_H_
+#include <esp_netif.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* configures the netif statically from the last DHCP lease while it is not due for renew,
+ * must be called before esp_wifi_start() */
+void ip_lease_apply(esp_netif_t* netif);
+/* IP_EVENT_STA_GOT_IP, remembers the lease obtained by DHCP */
+void ip_lease_store(const ip_event_got_ip_t* event);
+/* the lease did not work (address conflict, network changed), next wake goes through DHCP */
+void ip_lease_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* MAIN_IP_LEASE_H_ */
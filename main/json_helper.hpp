@@ -7,40 +7,176 @@
 
 #ifndef MAIN_JSON_HELPER_HPP_
 #define MAIN_JSON_HELPER_HPP_
+#include <climits>
 #include <cstdio>
-#include <string>
-#include "cJSON.h"
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
 
 namespace json {
-class CreateObject {
+/*
+ * streams unformatted JSON straight into the caller buffer, no heap.
+ * the output is byte identical to cJSON_PrintUnformatted of the same tree.
+ */
+class Writer {
  private:
-    cJSON* item;
+    char*  buf_;
+    size_t size_;
+    size_t pos_      = 0;
+    bool   first_    = true;
+    bool   overflow_ = false;
+
+    void put(char ch) {
+        if (pos_ + 1 < size_) {
+            buf_[pos_++] = ch;
+            buf_[pos_]   = 0;
+        } else {
+            overflow_ = true;
+        }
+    }
+
+    template<typename... Args>
+    void print(const char* format, Args... args) {
+        const auto left = size_ - pos_;
+        const auto cnt  = snprintf(buf_ + pos_, left, format, args...);
+        if (cnt < 0 || static_cast<size_t>(cnt) >= left) {
+            overflow_  = true;
+            buf_[pos_] = 0;
+        } else {
+            pos_ += cnt;
+        }
+    }
+
+    void string(const char* str) {
+        put('"');
+        for (; *str; str++) {
+            const auto ch = static_cast<unsigned char>(*str);
+            switch (ch) {
+                case '"':
+                case '\\':
+                    put('\\');
+                    put(ch);
+                    break;
+                case '\b':
+                    put('\\');
+                    put('b');
+                    break;
+                case '\f':
+                    put('\\');
+                    put('f');
+                    break;
+                case '\n':
+                    put('\\');
+                    put('n');
+                    break;
+                case '\r':
+                    put('\\');
+                    put('r');
+                    break;
+                case '\t':
+                    put('\\');
+                    put('t');
+                    break;
+                default:
+                    if (ch < 32) {
+                        print("\\u%04x", ch);
+                    } else {
+                        put(ch);
+                    }
+                    break;
+            }
+        }
+        put('"');
+    }
+
+    void key(const char* name) {
+        if (!first_) {
+            put(',');
+        }
+        first_ = false;
+        if (name) {
+            string(name);
+            put(':');
+        }
+    }
+
+    // cJSON print_number
+    void number(double val) {
+        if (val != val || val - val != 0) {
+            print("null");
+        } else if (val > INT_MIN && val < INT_MAX && val == static_cast<double>(static_cast<int>(val))) {
+            print("%d", static_cast<int>(val));
+        } else {
+            char   tt[26];
+            double test = 0;
+            snprintf(tt, sizeof(tt), "%1.15g", val);
+            if (sscanf(tt, "%lg", &test) != 1 || test != val) {
+                snprintf(tt, sizeof(tt), "%1.17g", val);
+            }
+            print("%s", tt);
+        }
+    }
 
  public:
-    CreateObject()
-        : item(cJSON_CreateObject()) {}
-    auto get() const {
-        return item;
+    Writer(char* buf, size_t size)
+        : buf_(buf)
+        , size_(size) {
+        buf_[0] = 0;
     }
-    ~CreateObject() {
-        cJSON_Delete(item);
+
+    // name is nullptr for the top level and array items
+    Writer& begin_object(const char* name = nullptr) {
+        key(name);
+        put('{');
+        first_ = true;
+        return *this;
+    }
+    Writer& end_object() {
+        put('}');
+        first_ = false;
+        return *this;
+    }
+    Writer& begin_array(const char* name = nullptr) {
+        key(name);
+        put('[');
+        first_ = true;
+        return *this;
+    }
+    Writer& end_array() {
+        put(']');
+        first_ = false;
+        return *this;
+    }
+
+    Writer& add(const char* name, const char* str) {
+        key(name);
+        string(str);
+        return *this;
+    }
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    Writer& add(const char* name, T val) {
+        key(name);
+        number(static_cast<double>(val));
+        return *this;
+    }
+    // raw value printed by the format, as cJSON_AddRawToObject
+    template<typename T>
+    Writer& add_formated(const char* name, const char* format, T val) {
+        key(name);
+        print(format, val);
+        return *this;
     }
-};
 
-inline std::string PrintUnformatted(const CreateObject& obj) {
-    const auto  my_json = cJSON_PrintUnformatted(obj.get());
-    std::string res(my_json);
-    cJSON_free(my_json);
-    return res;
-}
-
-template<typename T>
-void AddFormatedToObject(const CreateObject& obj, const char* const name, const char* format, T var) {
-    char       tt[255];
-    const auto cnt = snprintf(tt, sizeof(tt) - 1, format, var);
-    tt[cnt]        = 0;
-    cJSON_AddRawToObject(obj.get(), name, tt);
-}
+    bool ok() const {
+        return !overflow_;
+    }
+    const char* c_str() const {
+        return buf_;
+    }
+    size_t size() const {
+        return pos_;
+    }
+};
 
 } // namespace json
 
@@ -0,0 +1,306 @@
+/*
+ * mqtt_sn.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "mqtt_sn.hpp"
+#include <string.h>
+#include <string>
+#include "freertos/task.h"
+#include "lwip/netdb.h"
+#include "lwip/sockets.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "utils.hpp"
+
+#include "sdkconfig.h"
+
+#if CONFIG_MQTTSN
+namespace mqtt::transport {
+constexpr auto* TAG = "MQTT_SN";
+
+constexpr int STOPPED = BIT0;
+
+constexpr uint8_t CONNECT    = 0x04;
+constexpr uint8_t CONNACK    = 0x05;
+constexpr uint8_t PUBLISH    = 0x0C;
+constexpr uint8_t PUBACK     = 0x0D;
+constexpr uint8_t DISCONNECT = 0x18;
+
+constexpr uint8_t FLAG_DUP              = 0x80;
+constexpr uint8_t FLAG_QOS_1            = 0x20;
+constexpr uint8_t FLAG_QOS_MINUS_1      = 0x60;
+constexpr uint8_t FLAG_RETAIN           = 0x10;
+constexpr uint8_t FLAG_CLEAN_SESSION    = 0x04;
+constexpr uint8_t FLAG_TOPIC_PREDEFINED = 0x01;
+constexpr uint8_t PROTOCOL_ID           = 0x01;
+constexpr uint8_t RC_ACCEPTED           = 0x00;
+constexpr uint8_t RC_CONGESTION         = 0x01;
+
+constexpr uint16_t KEEP_ALIVE_S  = 60;
+constexpr int      RECV_TM_MS    = 50;
+constexpr size_t   CLIENT_ID_MAX = 23;
+
+#if CONFIG_MQTTSN_QOS_ONE
+constexpr bool    QOS_ONE  = true;
+constexpr int64_t RETRY_US = CONFIG_MQTTSN_RETRY_MS * 1000LL;
+#else
+constexpr bool    QOS_ONE  = false;
+constexpr int64_t RETRY_US = 0;
+#endif
+
+// the length is 1 byte, or 0x01 and 2 bytes when the message does not fit
+static void put_header(std::vector<uint8_t>& out, size_t body_len, uint8_t type) {
+    if (body_len + 2 < 256) {
+        out.push_back(body_len + 2);
+    } else {
+        const size_t len = body_len + 4;
+        out.push_back(0x01);
+        out.push_back(len >> 8);
+        out.push_back(len & 0xFF);
+    }
+    out.push_back(type);
+}
+
+static void put_u16(std::vector<uint8_t>& out, uint16_t val) {
+    out.push_back(val >> 8);
+    out.push_back(val & 0xFF);
+}
+
+static size_t header_len(const uint8_t* data) {
+    return data[0] == 0x01 ? 3 : 1;
+}
+
+static uint16_t get_u16(const uint8_t* data) {
+    return (data[0] << 8) | data[1];
+}
+
+// "prefix/<mac>"
+static bool has_prefix(const char* topic, const char* prefix) {
+    const size_t len = strlen(prefix);
+    return strncmp(topic, prefix, len) == 0 && topic[len] == '/';
+}
+
+// gateway pre-defined topic ids, the topics carry the MAC suffix
+static int topic_id(const char* topic) {
+    if (has_prefix(topic, CONFIG_MQTT_TOPIC_ADVERTISEMENT)) {
+        return CONFIG_MQTTSN_TOPIC_ID_ADVERTISEMENT;
+    }
+    if (has_prefix(topic, CONFIG_MQTT_TOPIC_SENSORS)) {
+        return CONFIG_MQTTSN_TOPIC_ID_SENSORS;
+    }
+    return -1;
+}
+
+CSn::CSn(IListener& listener)
+    : listener_(listener)
+    , event_group_(xEventGroupCreate()) {
+    ESP_LOGI(TAG, "gateway %s:%d qos %d", CONFIG_MQTTSN_GATEWAY_HOST, CONFIG_MQTTSN_GATEWAY_PORT, QOS_ONE ? 1 : -1);
+    addrinfo   hints = {};
+    addrinfo*  res   = nullptr;
+    const auto port  = std::to_string(CONFIG_MQTTSN_GATEWAY_PORT);
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(CONFIG_MQTTSN_GATEWAY_HOST, port.c_str(), &hints, &res) != 0 || !res) {
+        ESP_LOGE(TAG, "cannot resolve %s", CONFIG_MQTTSN_GATEWAY_HOST);
+        xEventGroupSetBits(event_group_, STOPPED);
+        return;
+    }
+    sock_ = socket(res->ai_family, res->ai_socktype, 0);
+    if (sock_ >= 0 && connect(sock_, res->ai_addr, res->ai_addrlen) != 0) {
+        close(sock_);
+        sock_ = -1;
+    }
+    freeaddrinfo(res);
+    if (sock_ < 0) {
+        ESP_LOGE(TAG, "socket errno=%d", errno);
+        xEventGroupSetBits(event_group_, STOPPED);
+        return;
+    }
+    const timeval tm = { .tv_sec = 0, .tv_usec = RECV_TM_MS * 1000 };
+    setsockopt(sock_, SOL_SOCKET, SO_RCVTIMEO, &tm, sizeof(tm));
+    // the listener is notified from the task, it may still be constructing
+    if (xTaskCreate(task, "mqtt_sn", 3072, this, 5, nullptr) != pdPASS) {
+        xEventGroupSetBits(event_group_, STOPPED);
+    }
+}
+
+CSn::~CSn() {
+    running_ = false;
+    xEventGroupWaitBits(event_group_, STOPPED, pdFALSE, pdTRUE, portMAX_DELAY);
+    if (QOS_ONE && connected_) {
+        std::vector<uint8_t> packet;
+        put_header(packet, 0, DISCONNECT);
+        send(packet);
+    }
+    if (sock_ >= 0) {
+        close(sock_);
+    }
+    vEventGroupDelete(event_group_);
+}
+
+void CSn::task(void* arg) {
+    auto* self = static_cast<CSn*>(arg);
+    self->run();
+    xEventGroupSetBits(self->event_group_, STOPPED);
+    vTaskDelete(nullptr);
+}
+
+void CSn::run() {
+    if (!QOS_ONE) {
+        // QoS -1 needs no connection
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            connected_ = true;
+        }
+        listener_.on_connected();
+        return;
+    }
+    uint8_t buf[16]; // CONNACK, PUBACK and DISCONNECT only
+    while (running_) {
+        resend();
+        const auto len = recv(sock_, buf, sizeof(buf), 0);
+        if (len >= 2) {
+            receive(buf, len);
+        }
+    }
+}
+
+bool CSn::send(const std::vector<uint8_t>& packet) {
+    if (::send(sock_, packet.data(), packet.size(), 0) < 0) {
+        ESP_LOGW(TAG, "send errno=%d", errno);
+        return false;
+    }
+    return true;
+}
+
+// CONNECT until CONNACK, then the unacknowledged PUBLISH with DUP
+void CSn::resend() {
+    const int64_t               now = esp_timer_get_time();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!connected_) {
+        if (connect_us_ && now - connect_us_ < RETRY_US) {
+            return;
+        }
+        connect_us_          = now;
+        const auto client_id = utils::get_mac().substr(0, CLIENT_ID_MAX);
+        std::vector<uint8_t> packet;
+        put_header(packet, 4 + client_id.size(), CONNECT);
+        packet.push_back(FLAG_CLEAN_SESSION);
+        packet.push_back(PROTOCOL_ID);
+        put_u16(packet, KEEP_ALIVE_S);
+        packet.insert(packet.end(), client_id.begin(), client_id.end());
+        send(packet);
+        return;
+    }
+    for (auto& item : pending_) {
+        if (now - item.sent_us >= RETRY_US) {
+            ESP_LOGI(TAG, "resend msg_id=%u", item.msg_id);
+            item.packet[header_len(item.packet.data()) + 1] |= FLAG_DUP;
+            item.sent_us = now;
+            send(item.packet);
+        }
+    }
+}
+
+void CSn::receive(const uint8_t* data, size_t len) {
+    const size_t hdr = header_len(data);
+    if (len < hdr + 1) {
+        return;
+    }
+    const uint8_t* body     = data + hdr + 1;
+    const size_t   body_len = len - hdr - 1;
+    switch (data[hdr]) {
+        case CONNACK:
+            if (body_len < 1 || body[0] != RC_ACCEPTED) {
+                ESP_LOGW(TAG, "connack rc=%d", body_len ? body[0] : -1);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (connected_) {
+                    return;
+                }
+                connected_ = true;
+            }
+            listener_.on_connected();
+            break;
+        case PUBACK: {
+            if (body_len < 5) {
+                return;
+            }
+            const uint16_t msg_id = get_u16(body + 2);
+            const uint8_t  rc     = body[4];
+            if (rc == RC_CONGESTION) {
+                return; // resent after RETRY_US
+            }
+            if (rc != RC_ACCEPTED) {
+                // rejected, the topic id is not pre-defined for the client
+                ESP_LOGE(TAG, "puback msg_id=%u rc=%d", msg_id, rc);
+            }
+            bool found = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+                    if (it->msg_id == msg_id) {
+                        pending_.erase(it);
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            // the duplicate of a resent one is dropped. the listener calls publish(), the mutex is not held
+            if (found) {
+                listener_.on_published(msg_id);
+            }
+            break;
+        }
+        case DISCONNECT:
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connected_  = false;
+                connect_us_ = 0;
+                pending_.clear();
+            }
+            // not acknowledged, the listener resends after CONNACK
+            listener_.on_disconnected();
+            break;
+        default:
+            break;
+    }
+}
+
+int CSn::publish(const outbox::message_t& msg) {
+    const int id = topic_id(msg.topic);
+    if (id < 0) {
+        ESP_LOGE(TAG, "no pre-defined topic id for %s", msg.topic);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!connected_) {
+        return -1;
+    }
+    uint16_t msg_id = 0;
+    if (QOS_ONE) {
+        msg_id = msg_id_ = msg_id_ % 0xFFFF + 1;
+    }
+    std::vector<uint8_t> packet;
+    packet.reserve(msg.msg_len + 10);
+    put_header(packet, 5 + msg.msg_len, PUBLISH);
+    packet.push_back(
+        (QOS_ONE ? FLAG_QOS_1 : FLAG_QOS_MINUS_1) | (msg.retain ? FLAG_RETAIN : 0) | FLAG_TOPIC_PREDEFINED);
+    put_u16(packet, id);
+    put_u16(packet, msg_id);
+    packet.insert(packet.end(), msg.msg, msg.msg + msg.msg_len);
+    const bool sent = send(packet);
+    if (!QOS_ONE) {
+        return sent ? 0 : -1;
+    }
+    // a failed send is retried as a lost datagram
+    pending_.push_back({ msg_id, esp_timer_get_time(), std::move(packet) });
+    return msg_id;
+}
+} // namespace mqtt::transport
+#endif
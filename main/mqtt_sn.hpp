@@ -0,0 +1,49 @@
+/*
+ * mqtt_sn.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "mqtt_transport.hpp"
+
+/*
+ * MQTT-SN 1.2 over UDP to CONFIG_MQTTSN_GATEWAY_HOST, topics are the gateway pre-defined ids.
+ * QoS -1 publishes without a connection, QoS 1 connects and resends until PUBACK.
+ */
+namespace mqtt::transport {
+class CSn: public ITransport {
+    using pending_t = struct {
+        uint16_t             msg_id;
+        int64_t              sent_us;
+        std::vector<uint8_t> packet;
+    };
+    IListener&             listener_;
+    int                    sock_ = -1;
+    EventGroupHandle_t     event_group_;
+    std::atomic<bool>      running_{ true };
+    std::mutex             mutex_;
+    bool                   connected_  = false;
+    int64_t                connect_us_ = 0;
+    uint16_t               msg_id_     = 0;
+    std::vector<pending_t> pending_; // sent and not acknowledged
+
+    static void task(void* arg);
+    void        run();
+    void        resend();
+    void        receive(const uint8_t* data, size_t len);
+    bool        send(const std::vector<uint8_t>& packet);
+
+ public:
+    explicit CSn(IListener& listener);
+    ~CSn();
+    int publish(const outbox::message_t& msg) final;
+};
+} // namespace mqtt::transport
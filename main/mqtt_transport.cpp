@@ -0,0 +1,46 @@
+/*
+ * mqtt_transport.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "mqtt_transport.hpp"
+#include "esp_log.h"
+
+#include "sdkconfig.h"
+
+namespace mqtt::transport {
+namespace imqtt = idf::mqtt;
+
+constexpr auto* TAG = "MQTT_TCP";
+constexpr int   QOS = 1; // at least once, acknowledged by MQTT_EVENT_PUBLISHED
+
+CTcp::CTcp(IListener& listener)
+    : imqtt::Client(imqtt::BrokerConfiguration{ .address = { imqtt::URI{ std::string{ CONFIG_BROKER_URL } } },
+                        .security                        = imqtt::Insecure{} },
+          {}, { .connection = { .disable_auto_reconnect = true } })
+    , listener_(listener) {
+    ESP_LOGI(TAG, "CONFIG_BROKER_URL %s", CONFIG_BROKER_URL);
+}
+
+CTcp::~CTcp() {
+    esp_mqtt_client_destroy(handler.get());
+}
+
+void CTcp::on_connected(const esp_mqtt_event_handle_t /*event*/) {
+    listener_.on_connected();
+}
+
+void CTcp::on_disconnected(const esp_mqtt_event_handle_t /*event*/) {
+    listener_.on_disconnected();
+}
+
+void CTcp::on_published(const esp_mqtt_event_handle_t event) {
+    listener_.on_published(event->msg_id);
+}
+
+int CTcp::publish(const outbox::message_t& msg) {
+    return esp_mqtt_client_publish(handler.get(), msg.topic, msg.msg, msg.msg_len, QOS, msg.retain);
+}
+} // namespace mqtt::transport
@@ -0,0 +1,49 @@
+/*
+ * mqtt_transport.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+#include "esp_mqtt.hpp"
+#include "esp_mqtt_client_config.hpp"
+#include "outbox.hpp"
+
+/*
+ * the link under CMQTTWrapper, the wrapper keeps the outbox queue and the in-flight window.
+ * the transport reports the connection and the acks from its own task.
+ */
+namespace mqtt::transport {
+class IListener {
+ public:
+    virtual void on_connected()           = 0;
+    virtual void on_disconnected()        = 0;
+    virtual void on_published(int msg_id) = 0;
+
+ protected:
+    ~IListener() = default;
+};
+
+class ITransport {
+ public:
+    virtual ~ITransport() = default;
+    // msg_id of the expected ack, 0 - not acknowledged (delivered once sent), <0 - failed
+    virtual int publish(const outbox::message_t& msg) = 0;
+};
+
+// MQTT 3.1.1 over TCP to CONFIG_BROKER_URL, QoS 1
+class CTcp: public ITransport, public idf::mqtt::Client {
+    IListener& listener_;
+
+    void on_connected(const esp_mqtt_event_handle_t event) final;
+    void on_disconnected(const esp_mqtt_event_handle_t event) final;
+    void on_published(const esp_mqtt_event_handle_t event) final;
+    void on_data(const esp_mqtt_event_handle_t event) final{};
+
+ public:
+    explicit CTcp(IListener& listener);
+    ~CTcp();
+    int publish(const outbox::message_t& msg) final;
+};
+} // namespace mqtt::transport
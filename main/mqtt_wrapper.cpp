@@ -13,76 +13,195 @@
 */
 
 #include "mqtt_wrapper.hpp"
+#include "mqtt_sn.hpp"
 #include "nvs_flash.h"
+#include "timing.hpp"
+#include "outbox.hpp"
 
 #include "esp_log.h"
+#include "esp_timer.h"
+#include <inttypes.h>
 #include <memory>
 
 #include "sdkconfig.h"
 
 namespace mqtt {
-namespace imqtt = idf::mqtt;
-
 constexpr auto* TAG         = "MQTT";
 constexpr int   EMPTY_QUEUE = BIT0;
 
-CMQTTWrapper::CMQTTWrapper(on_connect_cb_t&& cb)
-    : imqtt::Client(imqtt::BrokerConfiguration{ .address = { imqtt::URI{ std::string{ CONFIG_BROKER_URL } } },
-                        .security                        = imqtt::Insecure{} },
-          {}, { .connection = { .disable_auto_reconnect = true } })
-    , event_group_(xEventGroupCreate())
-    , on_connect_cb_(std::move(cb)) {
+CMQTTWrapper::CMQTTWrapper(on_connect_cb_t cb)
+    : event_group_(xEventGroupCreate())
+    , on_connect_cb_(cb)
+    , pm_lock_(ESP_PM_CPU_FREQ_MAX, "mqtt") {
     ESP_LOGD(TAG, "mqtt_wrapper ctor");
-    ESP_LOGI(TAG, "CONFIG_BROKER_URL %s", CONFIG_BROKER_URL);
+    // the transport callbacks wait for the lock until the ctor completes
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    outbox::restore([this](uint32_t seq) { send_queue_.push_back({ seq, 0, 0 }); });
+#if CONFIG_MQTTSN
+    transport_ = std::make_unique<transport::CSn>(static_cast<transport::IListener&>(*this));
+#else
+    transport_ = std::make_unique<transport::CTcp>(static_cast<transport::IListener&>(*this));
+#endif
 };
 
 CMQTTWrapper::~CMQTTWrapper() {
     ESP_LOGD(TAG, "mqtt_wrapper dtor");
-    esp_mqtt_client_destroy(handler.get());
+    transport_.reset();
+    vEventGroupDelete(event_group_);
 }
 
-void CMQTTWrapper::on_published(const esp_mqtt_event_handle_t /*event*/) {
-    ESP_LOGI(TAG, "on_published");
-    send_queue_.pop();
+void CMQTTWrapper::on_published(int msg_id) {
+    ESP_LOGI(TAG, "on_published msg_id=%d", msg_id);
+    timing::mark(timing::phase_e::PUBLISHED);
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (!acknowledged(msg_id)) {
+            if (!sending_) {
+                ESP_LOGW(TAG, "unknown msg_id=%d", msg_id);
+                return;
+            }
+            // the ack came before transport_->publish() returned the msg_id
+            early_ack_ = msg_id;
+        }
+    }
     send_queue();
 }
 
-void CMQTTWrapper::on_connected(esp_mqtt_event_handle_t const /*event*/) {
+void CMQTTWrapper::on_connected() {
     ESP_LOGI(TAG, "connected");
-    is_connected_ = true;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        is_connected_ = true;
+    }
     on_connect_cb_();
     send_queue();
 }
 
-void CMQTTWrapper::on_disconnected(const esp_mqtt_event_handle_t event) {
+void CMQTTWrapper::on_disconnected() {
     ESP_LOGI(TAG, "disconnected");
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     is_connected_ = false;
+    // not acknowledged, resent after reconnect
+    inflight_ = 0;
+}
+
+uint32_t CMQTTWrapper::reserve() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return outbox::reserve();
 }
 
-void CMQTTWrapper::publish(const std::string& topic, const std::string& message) {
+bool CMQTTWrapper::publish(
+    const std::string& topic, const std::string& message, bool persistent, bool retain, uint32_t seq) {
+#if CONFIG_PAYLOAD_BINARY
+    // the binary payload has zero bytes and no terminator of its own
+    ESP_LOGI(TAG, "add topic:%s, len=%zu", topic.c_str(), message.size());
+#else
     ESP_LOGI(TAG, "add topic:%s, msg:%s", topic.c_str(), message.c_str());
-    xEventGroupClearBits(event_group_, EMPTY_QUEUE);
-    send_queue_.push({ topic, message });
+#endif
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        seq = outbox::push(topic, message, persistent, retain, seq);
+        if (!seq) {
+            return false;
+        }
+        xEventGroupClearBits(event_group_, EMPTY_QUEUE);
+        send_queue_.push_back({ seq, 0, 0 });
+    }
     send_queue();
+    return true;
 }
 
 bool CMQTTWrapper::flush(const std::chrono::milliseconds timeout) {
-    ESP_LOGI(TAG, "flush tm=%lldms, queue=%d", timeout.count(), send_queue_.size());
-    if (!send_queue_.empty()) {
-        const TickType_t xTicksToWait = timeout.count() / portTICK_PERIOD_MS;
-        if (!xEventGroupWaitBits(event_group_, EMPTY_QUEUE, pdTRUE, pdFALSE, xTicksToWait)) {
-            return false;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        ESP_LOGI(TAG, "flush tm=%lldms, queue=%d", timeout.count(), send_queue_.size());
+        if (send_queue_.empty()) {
+            return true;
         }
     }
-    return true;
+    const int64_t start = esp_timer_get_time();
+    // completes when all in-flight messages are acknowledged
+    const TickType_t xTicksToWait = timeout.count() / portTICK_PERIOD_MS;
+    const bool       done
+        = xEventGroupWaitBits(event_group_, EMPTY_QUEUE, pdFALSE, pdFALSE, xTicksToWait) & EMPTY_QUEUE;
+    ESP_LOGI(TAG, "flush %s in %" PRId64 "us", done ? "done" : "timeout", esp_timer_get_time() - start);
+    return done;
 }
 
+// under mutex_
+bool CMQTTWrapper::acknowledged(int msg_id) {
+    for (size_t i = 0; i < inflight_; i++) {
+        if (send_queue_[i].msg_id == msg_id) {
+            ESP_LOGI(TAG, "ack seq=%" PRIu32 " latency=%" PRId64 "us inflight=%d", send_queue_[i].seq,
+                esp_timer_get_time() - send_queue_[i].sent_us, inflight_);
+            outbox::remove(send_queue_[i].seq);
+            send_queue_.erase(send_queue_.begin() + i);
+            inflight_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+// keeps up to CONFIG_MQTT_INFLIGHT_WINDOW messages waiting for the ack.
+// the transport is called without mutex_: esp-mqtt holds its API lock while it dispatches the events,
+// which take mutex_. one caller sends at a time, the others leave the queue to it
 void CMQTTWrapper::send_queue() {
-    ESP_LOGI(TAG, "send_queue sz=%d", send_queue_.size());
+    std::unique_lock<power::CLock>         pm(pm_lock_, std::defer_lock);
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    ESP_LOGI(TAG, "send_queue sz=%d, inflight=%d", send_queue_.size(), inflight_);
+    if (sending_) {
+        return;
+    }
+    while (is_connected_ && inflight_ < send_queue_.size() && inflight_ < CONFIG_MQTT_INFLIGHT_WINDOW) {
+        const uint32_t    seq = send_queue_[inflight_].seq;
+        outbox::message_t msg;
+        if (!outbox::get(seq, msg)) {
+            ESP_LOGE(TAG, "seq=%" PRIu32 " lost", seq);
+            send_queue_.erase(send_queue_.begin() + inflight_);
+            continue;
+        }
+        // the outbox buffer is valid till the next get()
+        const std::string topic(msg.topic);
+        const std::string data(msg.msg, msg.msg_len);
+        msg.topic  = topic.c_str();
+        msg.msg    = data.data();
+        sending_   = true;
+        early_ack_ = 0;
+        if (!pm.owns_lock()) {
+            pm.lock();
+        }
+        lock.unlock();
+        const int msg_id = transport_->publish(msg);
+        lock.lock();
+        sending_ = false;
+        // disconnected meanwhile, resent from the window start after reconnect
+        if (inflight_ >= send_queue_.size() || send_queue_[inflight_].seq != seq) {
+            continue;
+        }
+        if (msg_id < 0) {
+            ESP_LOGE(TAG, "publish failed topic:%s", topic.c_str());
+            break;
+        }
+        auto& item = send_queue_[inflight_];
+        if (msg_id == 0) {
+            // not acknowledged by the transport, delivered once sent
+            ESP_LOGI(TAG, "sent seq=%" PRIu32 " len=%zu", seq, data.size());
+            timing::mark(timing::phase_e::PUBLISHED);
+            outbox::remove(seq);
+            send_queue_.erase(send_queue_.begin() + inflight_);
+            continue;
+        }
+        item.msg_id  = msg_id;
+        item.sent_us = esp_timer_get_time();
+        inflight_++;
+        ESP_LOGI(TAG, "sent seq=%" PRIu32 " msg_id=%d len=%zu", seq, msg_id, data.size());
+        if (early_ack_ == msg_id) {
+            acknowledged(msg_id);
+        }
+    }
     if (send_queue_.empty()) {
         xEventGroupSetBits(event_group_, EMPTY_QUEUE);
-    } else if (is_connected_) {
-        imqtt::Client::publish(send_queue_.front().topic, imqtt::StringMessage(send_queue_.front().msg));
     }
 }
 
@@ -9,36 +9,52 @@
 #include <memory>
 #include <string.h>
 #include <chrono>
-#include <queue>
+#include <deque>
 #include <functional>
-#include "esp_mqtt.hpp"
-#include "esp_mqtt_client_config.hpp"
+#include <mutex>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "mqtt_transport.hpp"
+#include "power.hpp"
 
 namespace mqtt {
-class CMQTTWrapper: public idf::mqtt::Client {
+// the transport is MQTT over TCP, or MQTT-SN over UDP with CONFIG_MQTTSN
+class CMQTTWrapper: private transport::IListener {
  private:
     using msg_queue_t = struct {
-        std::string topic;
-        std::string msg;
+        uint32_t seq; // outbox:: message
+        int      msg_id;
+        int64_t  sent_us; // publish time, the ack latency is logged for tools/mqtt_bench.py
     };
-    using on_connect_cb_t = std::function<void()>;
-    std::queue<msg_queue_t> send_queue_;
-    bool                    is_connected_ = false;
-    EventGroupHandle_t      event_group_;
-    on_connect_cb_t         on_connect_cb_;
+    using on_connect_cb_t = void (*)();
+    // sent and not yet acknowledged messages are the first inflight_ entries
+    std::deque<msg_queue_t>                send_queue_;
+    size_t                                 inflight_     = 0;
+    bool                                   is_connected_ = false;
+    bool                                   sending_      = false; // transport_->publish() in progress
+    int                                    early_ack_    = 0;     // acknowledged before publish() returned
+    EventGroupHandle_t                     event_group_;
+    on_connect_cb_t                        on_connect_cb_;
+    std::recursive_mutex                   mutex_;
+    power::CLock                           pm_lock_; // CPU clock while publishing
+    std::unique_ptr<transport::ITransport> transport_;
 
  public:
-    CMQTTWrapper(on_connect_cb_t&& cb);
+    CMQTTWrapper(on_connect_cb_t cb);
     virtual ~CMQTTWrapper();
-    void publish(const std::string& topic, const std::string& message);
+    // the seq for a message which carries it, publish() it with that seq
+    uint32_t reserve();
+    // the message is kept in outbox:: until acknowledged, persistent messages are retried on the next wakes
+    bool publish(const std::string& topic, const std::string& message, bool persistent = true, bool retain = false,
+        uint32_t seq = 0);
     bool flush(const std::chrono::milliseconds timeout);
 
  private:
-    void on_connected(const esp_mqtt_event_handle_t event) final;
-    void on_disconnected(const esp_mqtt_event_handle_t event) final;
-    void on_published(const esp_mqtt_event_handle_t event) final;
-    void on_data(const esp_mqtt_event_handle_t event) final{};
+    void on_connected() final;
+    void on_disconnected() final;
+    void on_published(int msg_id) final;
 
+    bool acknowledged(int msg_id);
     void send_queue();
 };
 
@@ -0,0 +1,239 @@
+/*
+ * outbox.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "outbox.hpp"
+#include <algorithm>
+#include <array>
+#include <inttypes.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "sdkconfig.h"
+
+namespace mqtt::outbox {
+static const char* TAG = "OUTBOX";
+
+typedef struct {
+    uint32_t seq; // 0 - free
+    bool     persistent;
+    bool     retain;
+    uint16_t topic_len;
+    uint16_t msg_len;
+    char     data[CONFIG_MQTT_OUTBOX_SLOT_SIZE]; // topic\0msg
+} slot_t;
+
+static RTC_DATA_ATTR std::array<slot_t, CONFIG_MQTT_OUTBOX_SLOTS> slots;
+static RTC_DATA_ATTR uint32_t last_seq;
+
+// the seq continues after a power loss: NVS keeps the limit of the numbers handed out, a write per SEQ_BLOCK
+constexpr uint32_t            SEQ_BLOCK     = 64;
+static const char*            SEQ_NAMESPACE = "outbox_seq";
+static RTC_DATA_ATTR uint32_t seq_limit; // 0 - the RTC memory was lost
+
+#if CONFIG_MQTT_OUTBOX_NVS
+constexpr size_t NVS_MAX = CONFIG_MQTT_OUTBOX_NVS_MAX;
+#else
+constexpr size_t NVS_MAX = 0;
+#endif
+static RTC_DATA_ATTR size_t nvs_count;
+
+#if CONFIG_MQTT_OUTBOX_NVS
+static const char* NVS_NAMESPACE = "outbox";
+static std::string nvs_buf;
+
+static std::string nvs_key(uint32_t seq) {
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    snprintf(key, sizeof(key), "m%08" PRIx32, seq);
+    return key;
+}
+
+static bool nvs_push(uint32_t seq, const std::string& topic, const std::string& msg) {
+    if (nvs_count >= NVS_MAX) {
+        return false;
+    }
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return false;
+    }
+    std::string blob = topic;
+    blob += '\0';
+    blob += msg;
+    const auto res = nvs_set_blob(handle, nvs_key(seq).c_str(), blob.data(), blob.size());
+    if (res == ESP_OK) {
+        nvs_commit(handle);
+        nvs_count++;
+    }
+    nvs_close(handle);
+    return res == ESP_OK;
+}
+
+static bool nvs_get(uint32_t seq, message_t& out) {
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    const auto key = nvs_key(seq);
+    size_t     len = 0;
+    auto       res = nvs_get_blob(handle, key.c_str(), nullptr, &len);
+    if (res == ESP_OK) {
+        nvs_buf.resize(len);
+        res = nvs_get_blob(handle, key.c_str(), nvs_buf.data(), &len);
+    }
+    nvs_close(handle);
+    const auto topic_len = strnlen(nvs_buf.data(), nvs_buf.size());
+    if (res != ESP_OK || topic_len == nvs_buf.size()) {
+        return false;
+    }
+    out = { nvs_buf.data(), nvs_buf.data() + topic_len + 1, nvs_buf.size() - topic_len - 1, false };
+    return true;
+}
+
+static void nvs_remove(uint32_t seq) {
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(handle, nvs_key(seq).c_str()) == ESP_OK) {
+        nvs_commit(handle);
+        nvs_count--;
+    }
+    nvs_close(handle);
+}
+
+// the keys survive the power loss, seq continues after the largest one
+template<typename F>
+static void nvs_for_each(F&& f) {
+    nvs_iterator_t it  = nullptr;
+    auto           res = nvs_entry_find(NVS_DEFAULT_PART_NAME, NVS_NAMESPACE, NVS_TYPE_BLOB, &it);
+    nvs_count          = 0;
+    while (res == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+        const auto seq = static_cast<uint32_t>(strtoul(info.key + 1, nullptr, 16));
+        if (seq) {
+            nvs_count++;
+            last_seq = std::max(last_seq, seq);
+            f(seq);
+        }
+        res = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+}
+#endif
+
+static slot_t* find(uint32_t seq) {
+    auto it = std::find_if(slots.begin(), slots.end(), [seq](const auto& slot) { return slot.seq == seq; });
+    return it == slots.end() ? nullptr : &*it;
+}
+
+size_t room(const std::string& topic) {
+    return topic.size() + 1 < sizeof(slot_t::data) ? sizeof(slot_t::data) - topic.size() - 1 : 0;
+}
+
+static void seq_next_block() {
+    nvs_handle_t handle;
+    if (nvs_open(SEQ_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        ESP_LOGE(TAG, "seq limit not stored");
+        seq_limit = last_seq + SEQ_BLOCK;
+        return;
+    }
+    uint32_t stored = 0;
+    if (!seq_limit && nvs_get_u32(handle, "limit", &stored) == ESP_OK) {
+        last_seq = std::max(last_seq, stored);
+    }
+    seq_limit = last_seq + SEQ_BLOCK;
+    if (nvs_set_u32(handle, "limit", seq_limit) == ESP_OK) {
+        nvs_commit(handle);
+    }
+    nvs_close(handle);
+    ESP_LOGI(TAG, "seq from %" PRIu32 " up to %" PRIu32, last_seq + 1, seq_limit);
+}
+
+uint32_t reserve() {
+    if (last_seq >= seq_limit) {
+        seq_next_block();
+    }
+    return ++last_seq;
+}
+
+uint32_t push(const std::string& topic, const std::string& msg, bool persistent, bool retain, uint32_t seq) {
+    seq       = seq ? seq : reserve();
+    auto slot = find(0);
+    if (slot && topic.size() + 1 + msg.size() <= sizeof(slot->data)) {
+        memcpy(slot->data, topic.c_str(), topic.size() + 1);
+        memcpy(slot->data + topic.size() + 1, msg.data(), msg.size());
+        slot->topic_len  = topic.size();
+        slot->msg_len    = msg.size();
+        slot->persistent = persistent;
+        slot->retain     = retain;
+        slot->seq        = seq;
+        return seq;
+    }
+#if CONFIG_MQTT_OUTBOX_NVS
+    if (persistent && !retain && nvs_push(seq, topic, msg)) {
+        ESP_LOGI(TAG, "seq=%" PRIu32 " stored to NVS", seq);
+        return seq;
+    }
+#endif
+    ESP_LOGE(TAG, "no room for topic:%s, size=%d", topic.c_str(), msg.size());
+    return 0;
+}
+
+bool get(uint32_t seq, message_t& out) {
+    if (auto slot = find(seq)) {
+        out = { slot->data, slot->data + slot->topic_len + 1, slot->msg_len, slot->retain };
+        return true;
+    }
+#if CONFIG_MQTT_OUTBOX_NVS
+    return nvs_get(seq, out);
+#else
+    return false;
+#endif
+}
+
+void remove(uint32_t seq) {
+    if (auto slot = find(seq)) {
+        slot->seq = 0;
+        return;
+    }
+#if CONFIG_MQTT_OUTBOX_NVS
+    nvs_remove(seq);
+#endif
+}
+
+void restore(const std::function<void(uint32_t seq)>& cb) {
+    std::array<uint32_t, CONFIG_MQTT_OUTBOX_SLOTS + NVS_MAX> pending;
+    size_t                                                   cnt = 0;
+    for (auto& slot : slots) {
+        if (slot.seq && !slot.persistent) {
+            slot.seq = 0;
+        } else if (slot.seq) {
+            pending[cnt++] = slot.seq;
+        }
+    }
+#if CONFIG_MQTT_OUTBOX_NVS
+    nvs_for_each([&](uint32_t seq) {
+        // duplicated seq is already queued from RTC
+        if (cnt < pending.size() && !find(seq)) {
+            pending[cnt++] = seq;
+        }
+    });
+#endif
+    // the bound lets the compiler see the range within pending
+    const auto end = pending.begin() + std::min(cnt, pending.size());
+    std::sort(pending.begin(), end);
+    ESP_LOGI(TAG, "restored %d messages", cnt);
+    std::for_each(pending.begin(), end, cb);
+}
+
+bool empty() {
+    return !nvs_count
+        && std::none_of(slots.begin(), slots.end(), [](const auto& slot) { return slot.seq && slot.persistent; });
+}
+
+} // namespace mqtt::outbox
@@ -0,0 +1,41 @@
+/*
+ * outbox.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+/*
+ * preallocated MQTT outbox in RTC memory, survives the deep sleep.
+ * messages which do not fit RTC slots overflow to NVS (CONFIG_MQTT_OUTBOX_NVS).
+ * every message gets a sequence number, the message is kept until its seq is acknowledged.
+ */
+namespace mqtt::outbox {
+typedef struct {
+    const char* topic;
+    const char* msg;
+    size_t      msg_len;
+    bool        retain;
+} message_t;
+
+// the largest message of the topic which fits an RTC slot
+size_t room(const std::string& topic);
+// a seq taken ahead of push(), for the message which carries it
+uint32_t reserve();
+// returns seq, 0 - no room. volatile (not persistent) messages are dropped on the next wake.
+// retained messages are kept in RTC slots only. seq - reserve()d one, 0 - the next one
+uint32_t push(
+    const std::string& topic, const std::string& msg, bool persistent, bool retain = false, uint32_t seq = 0);
+// the message is valid till the next get()/remove()
+bool get(uint32_t seq, message_t& out);
+void remove(uint32_t seq);
+// pending messages from the previous wakes, the oldest first
+void restore(const std::function<void(uint32_t seq)>& cb);
+bool empty();
+} // namespace mqtt::outbox
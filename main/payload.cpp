@@ -0,0 +1,224 @@
+/*
+ * payload.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "payload.hpp"
+#include <cmath>
+#include "esp_log.h"
+#include "esp_mac.h"
+#include "sdkconfig.h"
+#include "batch.hpp"
+#include "diag.hpp"
+#include "json_helper.hpp"
+#include "power.hpp"
+#include "stats.hpp"
+#include "timing.hpp"
+#include "utils.hpp"
+
+namespace payload {
+
+// nearest step, the retained advertisement does not change with every dBm
+static int quantized(int rssi) {
+    constexpr int step = CONFIG_ADVERTISEMENT_RSSI_STEP;
+    return (rssi < 0 ? -((-rssi + step / 2) / step) : (rssi + step / 2) / step) * step;
+}
+
+#if CONFIG_PAYLOAD_BINARY
+/*
+ * version 1, little endian, see tools/payload_decode.py
+ * header:        u8 version, u8 kind
+ * sensors:       u8 mac[6], u32 seq, i8 rssi, u32 fast_connect_hits, u32 fast_connect_misses,
+ *                u8 count, count * { u32 boot_count, u8 flags, [flags & TIME: u32 epoch s],
+ *                [flags & BME280: i16 temperature*100, u16 humidity*100, u32 pressure*100],
+ *                [flags & SHT3X: i16 temperature*100, u16 humidity*100],
+ *                [flags & LIGHT: u32 lux*100], [flags & BATTERY: u16 mV] }, the oldest first
+ * advertisement: u8 mac[6], u8 ip[4], i8 rssi quantized, u8 len, char app_name[len]
+ * a layout change once the nodes are deployed bumps VERSION, the decoder keeps the older ones
+ */
+constexpr uint8_t VERSION            = 1;
+constexpr uint8_t KIND_SENSORS       = 1;
+constexpr uint8_t KIND_ADVERTISEMENT = 2;
+constexpr uint8_t FLAG_BME280        = 0x01;
+constexpr uint8_t FLAG_SHT3X         = 0x02;
+constexpr uint8_t FLAG_LIGHT         = 0x04;
+constexpr uint8_t FLAG_BATTERY       = 0x08;
+constexpr uint8_t FLAG_TIME          = 0x10;
+
+class writer {
+ public:
+    writer(uint8_t kind) {
+        u8(VERSION);
+        u8(kind);
+    }
+    void u8(uint8_t val) {
+        data_ += static_cast<char>(val);
+    }
+    void u16(uint16_t val) {
+        u8(val);
+        u8(val >> 8);
+    }
+    void u32(uint32_t val) {
+        u16(val);
+        u16(val >> 16);
+    }
+    void bytes(const void* val, size_t size) {
+        data_.append(static_cast<const char*>(val), size);
+    }
+    const std::string& get() const {
+        return data_;
+    }
+
+ private:
+    std::string data_;
+};
+
+static int32_t centi(float val) {
+    return static_cast<int32_t>(std::lround(val * 100));
+}
+
+// the node, MQTT-SN QoS -1 topics do not carry it
+static void put_mac(writer& out) {
+    uint8_t mac[6];
+    ESP_ERROR_CHECK(esp_read_mac(mac, ESP_MAC_WIFI_STA));
+    out.bytes(mac, sizeof(mac));
+}
+
+std::string advertisement(const advertisement_t& adv) {
+    writer out(KIND_ADVERTISEMENT);
+    put_mac(out);
+    out.bytes(&adv.ip, 4);
+    out.u8(static_cast<int8_t>(quantized(adv.rssi)));
+    const std::string name(CONFIG_APP_NAME);
+    out.u8(name.size());
+    out.bytes(name.data(), name.size());
+    return out.get();
+}
+
+std::string sensors(const link_t& link, uint32_t seq, size_t count) {
+    writer out(KIND_SENSORS);
+    put_mac(out);
+    out.u32(seq);
+    out.u8(static_cast<int8_t>(link.rssi));
+    out.u32(link.fast_connect_hits);
+    out.u32(link.fast_connect_misses);
+    out.u8(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto& sample = batch::at(i);
+        const auto& result = sample.result;
+        out.u32(sample.boot_count);
+        out.u8((result.bme280 ? FLAG_BME280 : 0) | (result.sht3x ? FLAG_SHT3X : 0) | (result.light ? FLAG_LIGHT : 0)
+               | (result.battery ? FLAG_BATTERY : 0) | (sample.time ? FLAG_TIME : 0));
+        if (sample.time) {
+            out.u32(sample.time);
+        }
+        if (result.bme280) {
+            out.u16(centi(result.bme280->temperature));
+            out.u16(centi(result.bme280->humidity));
+            out.u32(centi(result.bme280->pressure));
+        }
+        if (result.sht3x) {
+            out.u16(centi(result.sht3x->temperature));
+            out.u16(centi(result.sht3x->humidity));
+        }
+        if (result.light) {
+            out.u32(centi(*result.light));
+        }
+        if (result.battery) {
+            out.u16(std::lround(*result.battery * 1000));
+        }
+    }
+    return out.get();
+}
+
+#else
+static const char* TAG = "PAYLOAD";
+
+// the largest message is the sensors batch
+static char json_buf[sensors_max(CONFIG_BATCH_CAPACITY)];
+
+// empty when json_buf overflowed, the truncated JSON is not published
+static std::string to_string(const json::Writer& out) {
+    if (!out.ok()) {
+        ESP_LOGE(TAG, "json_buf overflow");
+        return {};
+    }
+    return std::string(out.c_str(), out.size());
+}
+
+std::string advertisement(const advertisement_t& adv) {
+    json::Writer out(json_buf, sizeof(json_buf));
+    out.begin_object()
+        .add("app_name", CONFIG_APP_NAME)
+        .add("ip", utils::to_Str(adv.ip).c_str())
+        .add("rssi", quantized(adv.rssi))
+        .add("mac", utils::get_mac().c_str())
+        .end_object();
+    return to_string(out);
+}
+
+static void add_sensors(json::Writer& out, const sensors::result_t& sensors) {
+    if (sensors.bme280) {
+        out.add_formated("temperature", "%.2f", sensors.bme280->temperature);
+        out.add_formated("humidity", "%.2f", sensors.bme280->humidity);
+        out.add_formated("pressure", "%.2f", sensors.bme280->pressure);
+    }
+    if (sensors.sht3x) {
+        out.add_formated("sht3x_temperature", "%.2f", sensors.sht3x->temperature);
+        out.add_formated("sht3x_humidity", "%.2f", sensors.sht3x->humidity);
+    }
+    if (sensors.light) {
+        out.add_formated("light", "%.2f", *sensors.light);
+    }
+    if (sensors.battery) {
+        out.add_formated("battery", "%.3f", *sensors.battery);
+    }
+}
+
+/*
+ * the latest sample of the message stays on the top level, all of them go to "samples", the oldest first.
+ * with CONFIG_STATS the aggregates of the window go to "stats" instead of the samples
+ */
+std::string sensors(const link_t& link, uint32_t seq, size_t count) {
+    const bool   newest = count == batch::size();
+    const auto&  latest = batch::at(count - 1);
+    json::Writer out(json_buf, sizeof(json_buf));
+    out.begin_object().add("mac", utils::get_mac().c_str()).add("seq", seq);
+    if (latest.time) {
+        out.add("time", latest.time);
+    }
+    add_sensors(out, latest.result);
+    if (stats::enabled() && newest) {
+        stats::add_json(out, "stats");
+    } else if (!stats::enabled() && count > 1) {
+        out.begin_array("samples");
+        for (size_t i = 0; i < count; i++) {
+            const auto& sample = batch::at(i);
+            out.begin_object().add("boot", sample.boot_count);
+            if (sample.time) {
+                out.add("time", sample.time);
+            }
+            add_sensors(out, sample.result);
+            out.end_object();
+        }
+        out.end_array();
+    }
+    out.begin_object("link")
+        .add("rssi", link.rssi)
+        .add("fast_connect_hits", link.fast_connect_hits)
+        .add("fast_connect_misses", link.fast_connect_misses)
+        .end_object();
+    if (newest) {
+        timing::add_previous(out, "timing");
+        power::add_previous(out, "pm");
+        diag::add_previous(out, "diag");
+    }
+    out.end_object();
+    return to_string(out);
+}
+
+#endif
+
+} // namespace payload
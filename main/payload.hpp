@@ -0,0 +1,43 @@
+/*
+ * payload.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include "esp_netif_ip_addr.h"
+
+namespace payload {
+
+// retained state, the rssi is quantized to CONFIG_ADVERTISEMENT_RSSI_STEP
+typedef struct {
+    esp_ip4_addr_t ip;
+    int            rssi;
+} advertisement_t;
+
+// volatile link quality of the wake, goes with the sensors
+typedef struct {
+    int      rssi;
+    uint32_t fast_connect_hits;
+    uint32_t fast_connect_misses;
+} link_t;
+
+// the JSON bound of a sensors message of samples, the binary one is smaller
+constexpr size_t sensors_max(size_t samples) {
+    return 768 + 192 * samples;
+}
+
+// CONFIG_PAYLOAD_JSON or CONFIG_PAYLOAD_BINARY encoded messages, empty when the message does not fit
+std::string advertisement(const advertisement_t& adv);
+/*
+ * the oldest count samples collected in batch::, the timing, pm, diag and stats of the wake go only with
+ * the newest one. seq - of the outbox, the receiver drops the resent duplicates by it
+ */
+std::string sensors(const link_t& link, uint32_t seq, size_t count);
+
+} // namespace payload
@@ -0,0 +1,160 @@
+/*
+ * power.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "power.hpp"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+namespace power {
+static const char* TAG = "POWER";
+
+constexpr size_t STATS_MAX = 4;
+
+typedef struct {
+    char     name[8];
+    uint32_t held_ms;
+} stat_t;
+
+// esp_pm_dump_locks() "Mode stats" names, the residency of the cycle by the clock the PM switched to
+constexpr const char* MODES[] = { "SLEEP", "APB_MIN", "APB_MAX", "CPU_MAX" };
+constexpr size_t      MODES_MAX = sizeof(MODES) / sizeof(MODES[0]);
+
+typedef struct {
+    size_t   cnt;
+    stat_t   stat[STATS_MAX];
+    bool     modes_valid;
+    uint32_t mode_ms[MODES_MAX];
+} stats_t;
+
+static stats_t               current;
+static RTC_DATA_ATTR stats_t previous;
+static int64_t               held_us[STATS_MAX];
+
+void init() {
+#if CONFIG_PM_ENABLE
+    const esp_pm_config_t config = {
+        .max_freq_mhz       = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz       = CONFIG_XTAL_FREQ,
+        .light_sleep_enable = true,
+    };
+    const auto res = esp_pm_configure(&config);
+    ESP_LOGI(TAG, "esp_pm_configure %d..%dMHz, res=%d", config.min_freq_mhz, config.max_freq_mhz, res);
+#endif
+}
+
+CLock::CLock(esp_pm_lock_type_t type, const char* name) {
+    if (esp_pm_lock_create(type, 0, name, &handle_) != ESP_OK) {
+        handle_ = nullptr;
+    }
+    for (stat_ = 0; stat_ < current.cnt; stat_++) {
+        if (!strncmp(current.stat[stat_].name, name, sizeof(stat_t::name) - 1)) {
+            return;
+        }
+    }
+    if (current.cnt < STATS_MAX) {
+        strlcpy(current.stat[current.cnt++].name, name, sizeof(stat_t::name));
+    }
+}
+
+CLock::~CLock() {
+    if (handle_) {
+        esp_pm_lock_delete(handle_);
+    }
+}
+
+void CLock::lock() {
+    if (handle_) {
+        esp_pm_lock_acquire(handle_);
+    }
+    if (!depth_++) {
+        since_ = esp_timer_get_time();
+    }
+}
+
+void CLock::unlock() {
+    if (!--depth_ && stat_ < STATS_MAX) {
+        held_us[stat_] += esp_timer_get_time() - since_;
+    }
+    if (handle_) {
+        esp_pm_lock_release(handle_);
+    }
+}
+
+#if CONFIG_PM_PROFILING
+// the time since boot in each mode, "SLEEP     40 M        123456      5 %" and "CPU_MAX   160M ..." lines of
+// esp_pm_dump_locks(), the clock is left-aligned in 3 columns before the M
+static bool read_modes(uint32_t (&mode_ms)[MODES_MAX]) {
+    char*  text = nullptr;
+    size_t size = 0;
+    FILE*  f    = open_memstream(&text, &size);
+    if (!f) {
+        return false;
+    }
+    esp_pm_dump_locks(f);
+    fclose(f);
+    bool  found = false;
+    char* save  = nullptr;
+    for (char* line = strtok_r(text, "\n", &save); line; line = strtok_r(nullptr, "\n", &save)) {
+        char     mode[9];
+        uint32_t mhz;
+        int64_t  time_us;
+        if (sscanf(line, "%8s %" SCNu32 " M %" SCNd64, mode, &mhz, &time_us) != 3) {
+            continue;
+        }
+        for (size_t i = 0; i < MODES_MAX; i++) {
+            if (!strcmp(mode, MODES[i])) {
+                mode_ms[i] = time_us / 1000;
+                found      = true;
+            }
+        }
+    }
+    free(text);
+    return found;
+}
+#endif
+
+void finish() {
+    for (size_t i = 0; i < current.cnt; i++) {
+        current.stat[i].held_ms = held_us[i] / 1000;
+        ESP_LOGI(TAG, "%s held %" PRIu32 "ms", current.stat[i].name, current.stat[i].held_ms);
+    }
+#if CONFIG_PM_PROFILING
+    current.modes_valid = read_modes(current.mode_ms);
+    for (size_t i = 0; current.modes_valid && i < MODES_MAX; i++) {
+        ESP_LOGI(TAG, "%s %" PRIu32 "ms", MODES[i], current.mode_ms[i]);
+    }
+#endif
+    previous = current;
+}
+
+void add_previous(json::Writer& out, const char* const name) {
+    if (!previous.cnt && !previous.modes_valid) {
+        return;
+    }
+    out.begin_object(name);
+    out.begin_object("held_ms");
+    for (size_t i = 0; i < previous.cnt; i++) {
+        out.add(previous.stat[i].name, previous.stat[i].held_ms);
+    }
+    out.end_object();
+    if (previous.modes_valid) {
+        out.begin_object("mode_ms");
+        for (size_t i = 0; i < MODES_MAX; i++) {
+            out.add(MODES[i], previous.mode_ms[i]);
+        }
+        out.end_object();
+    }
+    out.end_object();
+}
+
+} // namespace power
@@ -0,0 +1,42 @@
+/*
+ * power.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_pm.h"
+#include "json_helper.hpp"
+
+// DFS and automatic light sleep, the app code holds a lock while it needs the clock
+namespace power {
+void init();
+
+// BasicLockable, use with std::lock_guard. the held time is accounted per name
+class CLock {
+ public:
+    CLock(esp_pm_lock_type_t type, const char* name);
+    CLock(const CLock&)            = delete;
+    CLock& operator=(const CLock&) = delete;
+    ~CLock();
+    void lock();
+    void unlock();
+
+ private:
+    esp_pm_lock_handle_t handle_ = nullptr;
+    size_t               stat_;
+    int                  depth_ = 0;
+    int64_t              since_ = 0;
+};
+
+// keeps the held times and the mode residency of the cycle in RTC memory for the next wake
+void finish();
+/*
+ * the previous wake cycle, ms. held_ms - per lock, the locks overlap and do not set the clock alone.
+ * mode_ms - the time at each clock and in the light sleep, CONFIG_PM_PROFILING
+ */
+void add_previous(json::Writer& out, const char* const name);
+} // namespace power
@@ -14,6 +14,7 @@
 #include <freertos/task.h>
 #include <freertos/event_groups.h>
 
+#include <esp_attr.h>
 #include <esp_log.h>
 #include <esp_wifi.h>
 #include <esp_event.h>
@@ -22,6 +23,7 @@
 #include <wifi_provisioning/manager.h>
 
 #ifdef CONFIG_EXAMPLE_PROV_TRANSPORT_BLE
+#include <esp_bt.h>
 #include <wifi_provisioning/scheme_ble.h>
 #endif /* CONFIG_EXAMPLE_PROV_TRANSPORT_BLE */
 
@@ -29,6 +31,8 @@
 #include <wifi_provisioning/scheme_softap.h>
 #endif /* CONFIG_EXAMPLE_PROV_TRANSPORT_SOFTAP */
 #include "qrcode.h"
+#include "provision.h"
+#include "ip_lease.h"
 
 static const char* TAG = "provisioning";
 
@@ -95,6 +99,65 @@ static esp_err_t example_get_sec2_verifier(const char** verifier, uint16_t* veri
 /* Signal Wi-Fi events on this event-group */
 const int WIFI_CONNECTED_EVENT = BIT0;
 
+/* The last good AP, kept across the deep sleep so the next wake
+ * connects on the known channel/BSSID without the full scan.
+ * The credentials stay in the Wi-Fi NVS storage. */
+typedef struct {
+    bool             valid;
+    uint8_t          bssid[6];
+    uint8_t          channel;
+    wifi_auth_mode_t authmode;
+} wifi_fast_connect_t;
+
+static RTC_DATA_ATTR wifi_fast_connect_t fast_connect;
+static RTC_DATA_ATTR uint32_t            fast_connect_hits;
+static RTC_DATA_ATTR uint32_t            fast_connect_misses;
+static bool                              fast_connect_pending; /* current attempt uses the cache */
+static wifi_config_t                     stored_sta_cfg;       /* config without the cached AP */
+static esp_netif_t*                      sta_netif;
+
+static void fast_connect_apply(void) {
+    if (!fast_connect.valid || esp_wifi_get_config(WIFI_IF_STA, &stored_sta_cfg) != ESP_OK) {
+        return;
+    }
+    wifi_config_t wifi_cfg = stored_sta_cfg;
+    wifi_cfg.sta.bssid_set = true;
+    memcpy(wifi_cfg.sta.bssid, fast_connect.bssid, sizeof(wifi_cfg.sta.bssid));
+    wifi_cfg.sta.channel            = fast_connect.channel;
+    wifi_cfg.sta.scan_method        = WIFI_FAST_SCAN;
+    wifi_cfg.sta.threshold.authmode = fast_connect.authmode;
+    /* keep the NVS copy untouched */
+    ESP_ERROR_CHECK(esp_wifi_set_storage(WIFI_STORAGE_RAM));
+    if (esp_wifi_set_config(WIFI_IF_STA, &wifi_cfg) == ESP_OK) {
+        ESP_LOGI(TAG, "Fast connect to channel %d", fast_connect.channel);
+        fast_connect_pending = true;
+    }
+}
+
+static void fast_connect_fallback(void) {
+    ESP_LOGW(TAG, "Fast connect failed, falling back to the scan");
+    fast_connect.valid   = false;
+    fast_connect_pending = false;
+    fast_connect_misses++;
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &stored_sta_cfg));
+}
+
+static void fast_connect_store(const wifi_event_sta_connected_t* event) {
+    if (fast_connect_pending) {
+        fast_connect_hits++;
+        fast_connect_pending = false;
+    }
+    memcpy(fast_connect.bssid, event->bssid, sizeof(fast_connect.bssid));
+    fast_connect.channel  = event->channel;
+    fast_connect.authmode = event->authmode;
+    fast_connect.valid    = true;
+}
+
+void wifi_fast_connect_stat(uint32_t* hits, uint32_t* misses) {
+    *hits   = fast_connect_hits;
+    *misses = fast_connect_misses;
+}
+
 #define PROV_QR_VERSION "v1"
 #define PROV_TRANSPORT_SOFTAP "softap"
 #define PROV_TRANSPORT_BLE "ble"
@@ -153,8 +216,14 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
             case WIFI_EVENT_STA_START:
                 esp_wifi_connect();
                 break;
+            case WIFI_EVENT_STA_CONNECTED:
+                fast_connect_store((wifi_event_sta_connected_t*)event_data);
+                break;
             case WIFI_EVENT_STA_DISCONNECTED:
                 ESP_LOGI(TAG, "Disconnected. Connecting to the AP again...");
+                if (fast_connect_pending) {
+                    fast_connect_fallback();
+                }
                 esp_wifi_connect();
                 break;
 #ifdef CONFIG_EXAMPLE_PROV_TRANSPORT_SOFTAP
@@ -201,9 +270,24 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
 static void wifi_init_sta(void) {
     /* Start Wi-Fi in station mode */
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+    fast_connect_apply();
+    ip_lease_apply(sta_netif);
     ESP_ERROR_CHECK(esp_wifi_start());
 }
 
+/* Same check as wifi_prov_mgr_is_provisioned(): the STA config saved in NVS */
+static bool is_provisioned(void) {
+#ifdef CONFIG_EXAMPLE_RESET_PROVISIONED
+    return false;
+#else
+    wifi_config_t wifi_cfg;
+    if (esp_wifi_get_config(WIFI_IF_STA, &wifi_cfg) != ESP_OK) {
+        return false;
+    }
+    return strlen((const char*)wifi_cfg.sta.ssid) != 0;
+#endif
+}
+
 static void get_device_service_name(char* service_name, size_t max) {
     uint8_t     eth_mac[6];
     const char* ssid_prefix = "PROV_";
@@ -277,13 +361,24 @@ void provision_main(void) {
     ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &event_handler, NULL));
 
     /* Initialize Wi-Fi including netif with default config */
-    esp_netif_create_default_wifi_sta();
+    sta_netif = esp_netif_create_default_wifi_sta();
 #ifdef CONFIG_EXAMPLE_PROV_TRANSPORT_SOFTAP
     esp_netif_create_default_wifi_ap();
 #endif /* CONFIG_EXAMPLE_PROV_TRANSPORT_SOFTAP */
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
 
+    /* Provisioned device does not need the manager, protocomm and BT at all */
+    if (is_provisioned()) {
+        ESP_LOGI(TAG, "Already provisioned, starting Wi-Fi STA");
+#ifdef CONFIG_EXAMPLE_PROV_TRANSPORT_BLE
+        /* BLE is used for the provisioning only, release the controller and host memory, the C3 has no classic BT */
+        ESP_ERROR_CHECK(esp_bt_mem_release(ESP_BT_MODE_BLE));
+#endif /* CONFIG_EXAMPLE_PROV_TRANSPORT_BLE */
+        wifi_init_sta();
+        return;
+    }
+
     /* Configuration for the provisioning manager */
     wifi_prov_mgr_config_t config = {
     /* What is the Provisioning Scheme that we want ?
@@ -7,10 +7,13 @@
 
 #ifndef MAIN_PROVISION_H_
 #define MAIN_PROVISION_H_
+#include <stdint.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
 void provision_main(void);
+/* connections done from the RTC cached AP / fallbacks to the full scan */
+void wifi_fast_connect_stat(uint32_t* hits, uint32_t* misses);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,84 @@
+/*
+ * report.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "report.hpp"
+#include <cmath>
+#include <time.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+namespace report {
+
+typedef struct {
+    bool              valid;
+    time_t            time; // system time survives the deep sleep
+    sensors::result_t result;
+} last_t;
+
+static RTC_DATA_ATTR last_t last;
+
+bool deadband_enabled() {
+#if CONFIG_REPORT_DEADBAND
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool heartbeat_due() {
+#if CONFIG_REPORT_DEADBAND
+    const auto now = time(nullptr);
+    return !last.valid || now < last.time || now - last.time >= CONFIG_REPORT_HEARTBEAT_INTERVAL;
+#else
+    return false;
+#endif
+}
+
+std::chrono::seconds until_heartbeat() {
+#if CONFIG_REPORT_DEADBAND
+    if (heartbeat_due()) {
+        return std::chrono::seconds(0);
+    }
+    return std::chrono::seconds(CONFIG_REPORT_HEARTBEAT_INTERVAL - (time(nullptr) - last.time));
+#else
+    return std::chrono::seconds::max();
+#endif
+}
+
+#if CONFIG_REPORT_DEADBAND
+static const char* TAG = "REPORT";
+
+static bool out_of_band(float val, float ref, int band_centi) {
+    return std::fabs(val - ref) * 100 >= band_centi;
+}
+#endif
+
+bool changed(const sensors::result_t& result) {
+#if CONFIG_REPORT_DEADBAND
+    if (!last.valid || !result.bme280 || !last.result.bme280) {
+        return true;
+    }
+    const auto& cur = *result.bme280;
+    const auto& ref = *last.result.bme280;
+    const bool  res = out_of_band(cur.temperature, ref.temperature, CONFIG_REPORT_DEADBAND_TEMPERATURE)
+                  || out_of_band(cur.humidity, ref.humidity, CONFIG_REPORT_DEADBAND_HUMIDITY)
+                  || out_of_band(cur.pressure, ref.pressure, CONFIG_REPORT_DEADBAND_PRESSURE);
+    ESP_LOGI(TAG, "%s", res ? "changed" : "inside dead-band");
+    return res;
+#else
+    return true;
+#endif
+}
+
+void published(const sensors::result_t& result) {
+    last.valid  = true;
+    last.time   = time(nullptr);
+    last.result = result;
+}
+
+} // namespace report
@@ -0,0 +1,23 @@
+/*
+ * report.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <chrono>
+#include "collector.hpp"
+
+// dead-band (change driven) reporting policy
+namespace report {
+bool deadband_enabled();
+// nothing published for CONFIG_REPORT_HEARTBEAT_INTERVAL
+bool heartbeat_due();
+// time left until the heartbeat is due, 0 - due, max() when the dead-band reporting is disabled
+std::chrono::seconds until_heartbeat();
+// the sample is out of the dead-bands of the last published one, always true when disabled
+bool changed(const sensors::result_t& result);
+void published(const sensors::result_t& result);
+} // namespace report
@@ -0,0 +1,50 @@
+/*
+ * sht3x_wrapper.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "sht3x_wrapper.hpp"
+#include <mutex>
+#include "esp_log.h"
+
+namespace sensors {
+
+static const char* TAG = "SHT3X";
+
+CSHT3x_wrapper::CSHT3x_wrapper(i2c_bus_handle_t& i2c_bus)
+    : sht3x_(sht3x_create(i2c_bus, SHT3x_ADDR_PIN_SELECT_VSS))
+    , pm_lock_(ESP_PM_APB_FREQ_MAX, "i2c") {}
+
+CSHT3x_wrapper::~CSHT3x_wrapper() {
+    {
+        std::lock_guard<power::CLock> lock(pm_lock_);
+        // back to the idle single shot mode
+        sht3x_soft_reset(sht3x_);
+    }
+    sht3x_delete(&sht3x_);
+}
+
+std::optional<std::chrono::microseconds> CSHT3x_wrapper::start() {
+    std::lock_guard<power::CLock> lock(pm_lock_);
+    const auto                    res = sht3x_set_measure_mode(sht3x_, SHT3x_PER_2_HIGH);
+    ESP_LOGI(TAG, "sht3x_set_measure_mode:%d", res);
+    if (res != ESP_OK) {
+        return std::nullopt;
+    }
+    return MEASUREMENT_TM;
+}
+
+std::optional<sht3x_t> CSHT3x_wrapper::read() {
+    std::lock_guard<power::CLock> lock(pm_lock_);
+    sht3x_t                       data;
+    if (ESP_OK != sht3x_get_humiture(sht3x_, &data.temperature, &data.humidity)) {
+        ESP_LOGI(TAG, "sht3x not ready");
+        return std::nullopt;
+    }
+    ESP_LOGD(TAG, "temperature:%f, humidity:%f", data.temperature, data.humidity);
+    return data;
+}
+
+} // namespace sensors
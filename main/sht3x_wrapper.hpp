@@ -0,0 +1,42 @@
+/*
+ * sht3x_wrapper.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include "i2c_bus.h"
+#include "sht3x.h"
+#include "power.hpp"
+
+namespace sensors {
+
+typedef struct {
+    float temperature;
+    float humidity;
+} sht3x_t;
+
+// periodic mode is started, the first sample is fetched once converted. driven by utils::generic_sensor
+class CSHT3x_wrapper {
+ public:
+    using value_t                   = sht3x_t;
+    static constexpr auto RETRY_TM  = std::chrono::milliseconds(5);
+    static constexpr int  RETRY_MAX = 10;
+
+    CSHT3x_wrapper(i2c_bus_handle_t& i2c_bus);
+    ~CSHT3x_wrapper();
+
+    std::optional<std::chrono::microseconds> start();
+    std::optional<sht3x_t>                   read();
+
+ private:
+    static constexpr auto MEASUREMENT_TM = std::chrono::milliseconds(16);
+    sht3x_handle_t        sht3x_;
+    power::CLock          pm_lock_;
+};
+
+} // namespace sensors
@@ -0,0 +1,77 @@
+/*
+ * state.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "state.hpp"
+#include <stdint.h>
+#include <time.h>
+#include <algorithm>
+#include <array>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+namespace state {
+static const char* TAG = "STATE";
+
+constexpr size_t TOPICS = 4;
+
+typedef struct {
+    uint32_t topic;   // hash of the topic, 0 - free
+    uint32_t payload; // hash of the delivered payload
+    time_t   time;    // system time survives the deep sleep
+} entry_t;
+
+static RTC_DATA_ATTR std::array<entry_t, TOPICS> delivered;
+// queued on this wake, delivered when the cycle succeeds
+static std::array<entry_t, TOPICS> queued;
+static size_t                      queued_cnt = 0;
+
+// FNV-1a
+static uint32_t hash(const std::string& data) {
+    uint32_t res = 2166136261u;
+    for (const unsigned char ch : data) {
+        res = (res ^ ch) * 16777619u;
+    }
+    return res;
+}
+
+static entry_t entry(const std::string& topic, const std::string& payload) {
+    return { .topic = std::max<uint32_t>(hash(topic), 1), .payload = hash(payload), .time = time(nullptr) };
+}
+
+bool due(const std::string& topic, const std::string& payload) {
+    const entry_t cur = entry(topic, payload);
+    const auto    it
+        = std::find_if(delivered.begin(), delivered.end(), [&](const auto& entry) { return entry.topic == cur.topic; });
+    const bool res = it == delivered.end() || it->payload != cur.payload || cur.time < it->time
+                  || cur.time - it->time >= CONFIG_STATE_REFRESH_INTERVAL;
+    ESP_LOGI(TAG, "%s %s", topic.c_str(), res ? "due" : "unchanged");
+    return res;
+}
+
+void pending(const std::string& topic, const std::string& payload) {
+    if (queued_cnt < queued.size()) {
+        queued[queued_cnt++] = entry(topic, payload);
+    }
+}
+
+void published() {
+    for (size_t i = 0; i < queued_cnt; i++) {
+        const auto& cur = queued[i];
+        auto        it  = std::find_if(
+            delivered.begin(), delivered.end(), [&](const auto& entry) { return entry.topic == cur.topic; });
+        if (it == delivered.end()) {
+            // a free entry, otherwise the oldest one
+            it = std::min_element(delivered.begin(), delivered.end(), [](const auto& a, const auto& b) {
+                return !a.topic == !b.topic ? a.time < b.time : !a.topic;
+            });
+        }
+        *it = cur;
+    }
+    queued_cnt = 0;
+}
+} // namespace state
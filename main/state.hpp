@@ -0,0 +1,23 @@
+/*
+ * state.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <string>
+
+/*
+ * retained state topics. the hash of the delivered payload is kept in RTC memory,
+ * the topic is published again when the payload changed or CONFIG_STATE_REFRESH_INTERVAL elapsed
+ */
+namespace state {
+// true - publish the payload retained
+bool due(const std::string& topic, const std::string& payload);
+// the due payload is in the outbox, delivered when the cycle succeeds
+void pending(const std::string& topic, const std::string& payload);
+// the cycle delivered everything, the due payloads are the delivered ones now
+void published();
+} // namespace state
@@ -0,0 +1,123 @@
+/*
+ * stats.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "stats.hpp"
+#include <stdint.h>
+#include "esp_attr.h"
+#include "sdkconfig.h"
+
+namespace stats {
+
+#if CONFIG_STATS
+enum channel_e {
+    TEMPERATURE,
+    HUMIDITY,
+    PRESSURE,
+    SHT3X_TEMPERATURE,
+    SHT3X_HUMIDITY,
+    LIGHT,
+    BATTERY,
+    CHANNELS_NUM,
+};
+
+static const char* const channel_names[CHANNELS_NUM] = { "temperature", "humidity", "pressure", "sht3x_temperature",
+    "sht3x_humidity", "light", "battery" };
+
+typedef struct {
+    uint32_t count; // of the window
+    float    min;
+    float    max;
+    float    sum;
+    float    ema;
+    bool     ema_valid;
+} channel_t;
+
+static RTC_DATA_ATTR channel_t channels[CHANNELS_NUM];
+
+constexpr float EMA_ALPHA = CONFIG_STATS_EMA_ALPHA / 100.f;
+
+static std::optional<float> value(const sensors::result_t& result, size_t channel) {
+    switch (channel) {
+        case TEMPERATURE:
+            return result.bme280 ? std::optional<float>(result.bme280->temperature) : std::nullopt;
+        case HUMIDITY:
+            return result.bme280 ? std::optional<float>(result.bme280->humidity) : std::nullopt;
+        case PRESSURE:
+            return result.bme280 ? std::optional<float>(result.bme280->pressure) : std::nullopt;
+        case SHT3X_TEMPERATURE:
+            return result.sht3x ? std::optional<float>(result.sht3x->temperature) : std::nullopt;
+        case SHT3X_HUMIDITY:
+            return result.sht3x ? std::optional<float>(result.sht3x->humidity) : std::nullopt;
+        case LIGHT:
+            return result.light;
+        case BATTERY:
+            return result.battery;
+        default:
+            return std::nullopt;
+    }
+}
+
+static void add(channel_t& channel, float val) {
+    if (!channel.count) {
+        channel.min = channel.max = channel.sum = val;
+    } else {
+        channel.min = val < channel.min ? val : channel.min;
+        channel.max = val > channel.max ? val : channel.max;
+        channel.sum += val;
+    }
+    channel.count++;
+    channel.ema       = channel.ema_valid ? channel.ema + EMA_ALPHA * (val - channel.ema) : val;
+    channel.ema_valid = true;
+}
+#endif
+
+bool enabled() {
+#if CONFIG_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void add(const sensors::result_t& result) {
+#if CONFIG_STATS
+    for (size_t i = 0; i < CHANNELS_NUM; i++) {
+        if (const auto val = value(result, i)) {
+            add(channels[i], *val);
+        }
+    }
+#endif
+}
+
+void add_json(json::Writer& out, const char* const name) {
+#if CONFIG_STATS
+    out.begin_object(name);
+    for (size_t i = 0; i < CHANNELS_NUM; i++) {
+        const auto& channel = channels[i];
+        if (channel.count) {
+            out.begin_object(channel_names[i])
+                .add("n", channel.count)
+                .add_formated("min", "%.2f", channel.min)
+                .add_formated("max", "%.2f", channel.max)
+                .add_formated("mean", "%.2f", channel.sum / channel.count)
+                .add_formated("ema", "%.2f", channel.ema)
+                .end_object();
+        }
+    }
+    out.end_object();
+#endif
+}
+
+void published() {
+#if CONFIG_STATS
+    for (auto& channel : channels) {
+        channel.count = 0;
+    }
+#endif
+}
+
+} // namespace stats
@@ -0,0 +1,24 @@
+/*
+ * stats.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include "collector.hpp"
+#include "json_helper.hpp"
+
+/*
+ * streaming min/max/mean/EMA of every measured value, kept in RTC memory across wakes.
+ * the window is the upload period, the EMA runs over the windows
+ */
+namespace stats {
+bool enabled();
+// every collected sample, including the ones inside the dead-bands or taken by the wake stub
+void add(const sensors::result_t& result);
+void add_json(json::Writer& out, const char* const name);
+// the window was delivered
+void published();
+} // namespace stats
@@ -0,0 +1,102 @@
+/*
+ * timekeeping.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "timekeeping.hpp"
+#include <algorithm>
+#include <inttypes.h>
+#include <sys/time.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_netif_sntp.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+namespace timekeeping {
+static const char* TAG = "TIME";
+
+constexpr int64_t    US                   = 1000000;
+constexpr int64_t    PPB                  = 1000000000;
+constexpr int64_t    DRIFT_MIN_ELAPSED_US = 1800 * US;    // shorter spans are dominated by the SNTP error
+constexpr int64_t    DRIFT_MAX_PPB        = 2000000;      // 2000 ppm, larger - the time was set by someone else
+constexpr int64_t    CORRECT_MAX_US       = 2592000 * US; // 30 days corrected at most, 86 min at DRIFT_MAX_PPB
+constexpr int32_t    DRIFT_WEIGHT         = 4;            // EMA of the measured drifts, 1/4
+constexpr TickType_t FINISH_WAIT          = pdMS_TO_TICKS(1000);
+
+typedef struct {
+    int64_t sync_us;   // epoch of the last sync, the system time was set to it
+    int32_t drift_ppb; // (true - system) / system elapsed
+    bool    drift_valid;
+} state_t;
+
+RTC_DATA_ATTR static state_t state;
+
+// the system time when SNTP was started, the esp_timer then
+static int64_t start_system_us;
+static int64_t start_timer_us;
+static bool    started = false;
+
+static int64_t system_us() {
+    timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec * US + tv.tv_usec;
+}
+
+// the span is clamped, its product with the drift stays within int64
+static_assert(CORRECT_MAX_US <= INT64_MAX / DRIFT_MAX_PPB);
+
+static int64_t corrected(int64_t system) {
+    const int64_t elapsed = std::clamp<int64_t>(system - state.sync_us, 0, CORRECT_MAX_US);
+    return system + elapsed * state.drift_ppb / PPB;
+}
+
+int64_t now_us() {
+    return state.sync_us ? corrected(system_us()) : 0;
+}
+
+bool sync_due() {
+    return !state.sync_us || system_us() - state.sync_us >= CONFIG_SNTP_SYNC_INTERVAL * US;
+}
+
+// lwip task, the system time is already set
+static void on_sync(timeval* tv) {
+    const int64_t synced = tv->tv_sec * US + tv->tv_usec;
+    // the system time without the sync, esp_timer runs from the crystal
+    const int64_t system  = start_system_us + esp_timer_get_time() - start_timer_us;
+    const int64_t elapsed = system - state.sync_us;
+    if (state.sync_us && elapsed >= DRIFT_MIN_ELAPSED_US) {
+        // error us * 1000 / elapsed s is ppb, error * PPB would overflow from 2.5 h of error
+        const int64_t ppb = (synced - system) * (PPB / US) / (elapsed / US);
+        ESP_LOGI(TAG, "error %" PRId64 "ms, corrected %" PRId64 "ms over %" PRId64 "s, drift %" PRId64 "ppb",
+            (synced - system) / 1000, (synced - corrected(system)) / 1000, elapsed / US, ppb);
+        if (ppb > -DRIFT_MAX_PPB && ppb < DRIFT_MAX_PPB) {
+            state.drift_ppb   = state.drift_valid ? state.drift_ppb + (ppb - state.drift_ppb) / DRIFT_WEIGHT : ppb;
+            state.drift_valid = true;
+        }
+    }
+    state.sync_us = synced;
+}
+
+void sync() {
+    ESP_LOGI(TAG, "sntp %s", CONFIG_SNTP_SERVER);
+    start_system_us          = system_us();
+    start_timer_us           = esp_timer_get_time();
+    esp_sntp_config_t config = ESP_NETIF_SNTP_DEFAULT_CONFIG(CONFIG_SNTP_SERVER);
+    config.sync_cb           = on_sync;
+    started                  = esp_netif_sntp_init(&config) == ESP_OK;
+}
+
+void finish() {
+    if (!started) {
+        return;
+    }
+    if (esp_netif_sntp_sync_wait(FINISH_WAIT) != ESP_OK) {
+        ESP_LOGW(TAG, "not synced");
+    }
+    esp_netif_sntp_deinit();
+    started = false;
+}
+} // namespace timekeeping
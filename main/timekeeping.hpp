@@ -0,0 +1,26 @@
+/*
+ * timekeeping.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * epoch time across the deep sleep. the system time runs from the RTC slow clock while
+ * sleeping, SNTP sets it once per CONFIG_SNTP_SYNC_INTERVAL. the error found by each sync
+ * gives the slow clock drift, the time between the syncs is corrected by it.
+ */
+namespace timekeeping {
+// drift corrected epoch time, us. 0 - never synced
+int64_t now_us();
+// never synced or CONFIG_SNTP_SYNC_INTERVAL elapsed
+bool sync_due();
+// starts SNTP, the network is up
+void sync();
+// waits a little for the started sync, stops SNTP
+void finish();
+} // namespace timekeeping
@@ -0,0 +1,75 @@
+/*
+ * timing.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "timing.hpp"
+#include <inttypes.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "diag.hpp"
+
+namespace timing {
+static const char* TAG = "TIMING";
+
+constexpr size_t PHASES_NUM    = static_cast<size_t>(phase_e::DEEP_SLEEP) + 1;
+constexpr size_t PUBLISHED_MAX = 4;
+
+typedef struct {
+    bool     valid;
+    uint32_t phase_ms[PHASES_NUM]; // 0 - not reached
+    uint32_t published_ms[PUBLISHED_MAX];
+    uint8_t  published_cnt;
+} cycle_t;
+
+static cycle_t               current;
+static RTC_DATA_ATTR cycle_t previous;
+
+static const char* const phase_names[PHASES_NUM] = { "boot", "nvs", "wifi_start", "assoc", "got_ip", "mqtt",
+    "sensors", "published", "sleep" };
+
+void mark(phase_e phase) {
+    const auto ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    if (phase == phase_e::PUBLISHED) {
+        if (current.published_cnt < PUBLISHED_MAX) {
+            current.published_ms[current.published_cnt++] = ms;
+        }
+    }
+    current.phase_ms[static_cast<size_t>(phase)] = ms;
+    ESP_LOGD(TAG, "%s at %" PRIu32 "ms", phase_names[static_cast<size_t>(phase)], ms);
+    diag::sample(phase);
+}
+
+const char* phase_name(phase_e phase) {
+    return phase_names[static_cast<size_t>(phase)];
+}
+
+void finish() {
+    mark(phase_e::DEEP_SLEEP);
+    current.valid = true;
+    previous      = current;
+}
+
+void add_previous(json::Writer& out, const char* const name) {
+    if (!previous.valid) {
+        return;
+    }
+    out.begin_object(name);
+    for (size_t i = 0; i < PHASES_NUM; i++) {
+        if (i == static_cast<size_t>(phase_e::PUBLISHED)) {
+            out.begin_array(phase_names[i]);
+            for (size_t j = 0; j < previous.published_cnt; j++) {
+                out.add(nullptr, previous.published_ms[j]);
+            }
+            out.end_array();
+        } else if (previous.phase_ms[i]) {
+            out.add(phase_names[i], previous.phase_ms[i]);
+        }
+    }
+    out.end_object();
+}
+
+} // namespace timing
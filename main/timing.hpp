@@ -0,0 +1,33 @@
+/*
+ * timing.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "json_helper.hpp"
+
+namespace timing {
+enum class phase_e : uint8_t {
+    BOOT,
+    NVS_INIT,
+    WIFI_START,
+    ASSOCIATED,
+    GOT_IP,
+    MQTT_CONNECTED,
+    SENSORS_DONE,
+    PUBLISHED, // each on_published
+    DEEP_SLEEP,
+};
+
+// esp_timer_get_time() of the phase boundary in the current wake cycle, diag:: is sampled as well
+void        mark(phase_e phase);
+const char* phase_name(phase_e phase);
+// marks DEEP_SLEEP and keeps the cycle in RTC memory for the next wake
+void finish();
+// timings of the previous wake cycle, ms
+void add_previous(json::Writer& out, const char* const name);
+} // namespace timing
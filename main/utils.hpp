@@ -6,29 +6,149 @@
 
 #pragma once
 
-#include <functional>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
 #include <string>
+#include "esp_err.h"
 #include "esp_netif_ip_addr.h"
+#include "esp_timer.h"
 
 namespace utils {
 std::string num_to_hex_string(const uint8_t* input, size_t size, char separator = 0);
 std::string get_mac();
 std::string to_Str(const esp_ip4_addr_t& ip);
 
-template<typename T>
+/*
+ * one-shot esp_timer calling Owner::Fn on the esp_timer task through a static trampoline,
+ * no std::function as in ESPTimer. esp_timer_create() still allocates the timer itself
+ */
+template<typename Owner, void (Owner::*Fn)()>
+class member_timer {
+ public:
+    member_timer(Owner* owner, const char* name) {
+        const esp_timer_create_args_t args = {
+            .callback              = trampoline,
+            .arg                   = owner,
+            .dispatch_method       = ESP_TIMER_TASK,
+            .name                  = name,
+            .skip_unhandled_events = false,
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&args, &handle_));
+    }
+    member_timer(const member_timer&)            = delete;
+    member_timer& operator=(const member_timer&) = delete;
+    ~member_timer() {
+        esp_timer_stop(handle_);
+        esp_timer_delete(handle_);
+    }
+    void start(std::chrono::microseconds timeout) {
+        ESP_ERROR_CHECK(esp_timer_start_once(handle_, timeout.count()));
+    }
+
+ private:
+    esp_timer_handle_t handle_ = nullptr;
+
+    static void trampoline(void* arg) {
+        (static_cast<Owner*>(arg)->*Fn)();
+    }
+};
+
+/*
+ * drives a Device through one measurement and hands the outcome to Cb with a direct call.
+ * Device: value_t, RETRY_TM, RETRY_MAX, constructed from the bus,
+ *         std::optional<std::chrono::microseconds> start() - delay of the first read, nullopt on failure,
+ *         std::optional<value_t> read() - nullopt until the conversion is completed
+ * Cb:     void operator()(const std::optional<value_t>&), called once: the value, or nullopt when start()
+ *         failed (from the constructor) or read() did not complete within RETRY_MAX retries (esp_timer task)
+ */
+template<typename Device, typename Cb>
 class generic_sensor {
  public:
-    using cb_t = std::function<void(const T&)>;
-    generic_sensor(cb_t&& cb)
-        : cb_(std::move(cb)) {}
+    template<typename Bus>
+    generic_sensor(Bus& bus, Cb cb)
+        : dev_(bus)
+        , cb_(cb)
+        , timer_(this, "sensor") {
+        if (const auto delay = dev_.start()) {
+            timer_.start(*delay);
+        } else {
+            cb_(std::nullopt);
+        }
+    }
+    generic_sensor(const generic_sensor&)            = delete;
+    generic_sensor& operator=(const generic_sensor&) = delete;
+
+ private:
+    void poll() {
+        if (const auto val = dev_.read()) {
+            cb_(val);
+        } else if (++retry_cnt_ <= Device::RETRY_MAX) {
+            timer_.start(Device::RETRY_TM);
+        } else {
+            cb_(std::nullopt);
+        }
+    }
+
+    Device                                              dev_;
+    Cb                                                  cb_;
+    member_timer<generic_sensor, &generic_sensor::poll> timer_;
+    int                                                 retry_cnt_ = 0;
+};
 
- protected:
-    void set(const T& val) {
-        cb_(val);
+/*
+ * fixed capacity FIFO, the oldest element is dropped when full.
+ * trivially constructible so it can live in RTC_DATA_ATTR memory
+ */
+template<typename T, size_t N>
+class ring_buffer {
+ public:
+    static constexpr size_t capacity() {
+        return N;
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    bool full() const {
+        return size_ == N;
+    }
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+    void push(const T& val) {
+        data_[(head_ + size_) % N] = val;
+        if (full()) {
+            head_ = (head_ + 1) % N;
+        } else {
+            size_++;
+        }
+    }
+    void pop() {
+        if (!empty()) {
+            head_ = (head_ + 1) % N;
+            size_--;
+        }
+    }
+    const T& front() const {
+        return data_[head_];
+    }
+    const T& back() const {
+        return data_[(head_ + size_ - 1) % N];
+    }
+    // 0 - the oldest
+    const T& operator[](size_t idx) const {
+        return data_[(head_ + idx) % N];
     }
 
  private:
-    cb_t cb_;
+    std::array<T, N> data_ = {};
+    size_t           head_ = 0;
+    size_t           size_ = 0;
 };
 
 } // namespace utils
@@ -0,0 +1,300 @@
+/*
+ * wake_stub.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#include "wake_stub.hpp"
+#include <algorithm>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "esp_wake_stub.h"
+#include "soc/gpio_reg.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/io_mux_reg.h"
+#include "sdkconfig.h"
+#include "batch.hpp"
+#include "outbox.hpp"
+#include "report.hpp"
+
+namespace wake_stub {
+
+#if CONFIG_WAKE_STUB_PRESCREEN
+static const char* TAG = "STUB";
+
+/*
+ * everything below up to arm() runs before the flash cache is enabled:
+ * RTC_IRAM_ATTR code, RTC_DATA_ATTR data, ROM functions only. no rodata, no libgcc
+ */
+constexpr uint32_t SDA            = BIT(CONFIG_I2C_MASTER_SDA_IO);
+constexpr uint32_t SCL            = BIT(CONFIG_I2C_MASTER_SCL_IO);
+constexpr uint32_t HALF_PERIOD_US = 5; // ~100kHz
+constexpr int      STRETCH_MAX_US = 1000;
+constexpr uint8_t  ADDRESS        = BME280_I2C_ADDRESS_DEFAULT;
+
+typedef struct {
+    int                   boot_count;
+    sensors::bme280_raw_t raw;
+} sample_t;
+
+typedef struct {
+    bool                  armed;
+    uint8_t               budget; // samples before the full boot
+    uint8_t               count;
+    uint8_t               ctrl_hum;
+    uint8_t               ctrl_meas; // forced mode
+    uint32_t              delay_us;  // conversion time
+    uint64_t              interval_us;
+    sensors::bme280_raw_t ref;
+    sensors::bme280_raw_t delta; // 0 - not checked
+    sample_t              samples[CONFIG_WAKE_STUB_SAMPLES];
+} stub_t;
+
+static RTC_DATA_ATTR stub_t stub;
+
+// open drain: the line is released high to the pull-ups or driven low
+static void RTC_IRAM_ATTR line(uint32_t mask, bool high) {
+    REG_WRITE(high ? GPIO_ENABLE_W1TC_REG : GPIO_ENABLE_W1TS_REG, mask);
+    esp_rom_delay_us(HALF_PERIOD_US);
+}
+
+static bool RTC_IRAM_ATTR sda() {
+    return REG_READ(GPIO_IN_REG) & SDA;
+}
+
+static void RTC_IRAM_ATTR scl_high() {
+    line(SCL, true);
+    // clock stretching
+    for (int i = 0; i < STRETCH_MAX_US && !(REG_READ(GPIO_IN_REG) & SCL); i++) {
+        esp_rom_delay_us(1);
+    }
+}
+
+static void RTC_IRAM_ATTR pin_init(uint32_t pin) {
+    const uint32_t mux = IO_MUX_GPIO0_REG + 4 * pin;
+    PIN_FUNC_SELECT(mux, PIN_FUNC_GPIO);
+    PIN_INPUT_ENABLE(mux);
+    PIN_PULLUP_EN(mux);
+    REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + 4 * pin, SIG_GPIO_OUT_IDX);
+}
+
+static void RTC_IRAM_ATTR bus_init() {
+    pin_init(CONFIG_I2C_MASTER_SDA_IO);
+    pin_init(CONFIG_I2C_MASTER_SCL_IO);
+    REG_WRITE(GPIO_OUT_W1TC_REG, SDA | SCL);
+    REG_WRITE(GPIO_ENABLE_W1TC_REG, SDA | SCL);
+    esp_rom_delay_us(HALF_PERIOD_US);
+}
+
+static void RTC_IRAM_ATTR start() {
+    line(SDA, true);
+    scl_high();
+    line(SDA, false);
+    line(SCL, false);
+}
+
+static void RTC_IRAM_ATTR stop() {
+    line(SDA, false);
+    scl_high();
+    line(SDA, true);
+}
+
+static bool RTC_IRAM_ATTR write_byte(uint8_t val) {
+    for (int i = 7; i >= 0; i--) {
+        line(SDA, (val >> i) & 1);
+        scl_high();
+        line(SCL, false);
+    }
+    line(SDA, true);
+    scl_high();
+    const bool ack = !sda();
+    line(SCL, false);
+    return ack;
+}
+
+static uint8_t RTC_IRAM_ATTR read_byte(bool ack) {
+    uint8_t val = 0;
+    line(SDA, true);
+    for (int i = 0; i < 8; i++) {
+        scl_high();
+        val = (val << 1) | (sda() ? 1 : 0);
+        line(SCL, false);
+    }
+    line(SDA, !ack);
+    scl_high();
+    line(SCL, false);
+    line(SDA, true);
+    return val;
+}
+
+static bool RTC_IRAM_ATTR write_reg(uint8_t reg, uint8_t val) {
+    start();
+    const bool res = write_byte(ADDRESS << 1) && write_byte(reg) && write_byte(val);
+    stop();
+    return res;
+}
+
+static bool RTC_IRAM_ATTR read_regs(uint8_t reg, uint8_t* data, int len) {
+    start();
+    bool res = write_byte(ADDRESS << 1) && write_byte(reg);
+    if (res) {
+        start(); // repeated
+        res = write_byte((ADDRESS << 1) | 1);
+        for (int i = 0; res && i < len; i++) {
+            data[i] = read_byte(i + 1 < len);
+        }
+    }
+    stop();
+    return res;
+}
+
+// bme280_parse_raw() lives in flash
+static bool RTC_IRAM_ATTR measure(sensors::bme280_raw_t& raw) {
+    bus_init();
+    if (!write_reg(sensors::BME280_REG_CTRL_HUM, stub.ctrl_hum)
+        || !write_reg(sensors::BME280_REG_CTRL_MEAS, stub.ctrl_meas)) {
+        return false;
+    }
+    esp_rom_delay_us(stub.delay_us);
+    uint8_t data[sensors::BME280_DATA_SIZE];
+    if (!read_regs(sensors::BME280_REG_DATA, data, sizeof(data))) {
+        return false;
+    }
+    raw.pressure    = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4);
+    raw.temperature = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4);
+    raw.humidity    = (data[6] << 8) | data[7];
+    return raw.temperature != sensors::BME280_ADC_SKIPPED;
+}
+
+static bool RTC_IRAM_ATTR crossed(int32_t val, int32_t ref, int32_t delta) {
+    const int32_t diff = val > ref ? val - ref : ref - val;
+    return delta && diff >= delta;
+}
+
+bool RTC_IRAM_ATTR run(int boot_count) {
+    if (!stub.armed) {
+        return false;
+    }
+    // re-armed by the full boot
+    stub.armed = false;
+    if (stub.count >= stub.budget) {
+        return false;
+    }
+    sensors::bme280_raw_t raw;
+    if (!measure(raw)) {
+        return false;
+    }
+    auto& sample           = stub.samples[stub.count++];
+    sample.boot_count      = boot_count;
+    sample.raw.temperature = raw.temperature;
+    sample.raw.pressure    = raw.pressure;
+    sample.raw.humidity    = raw.humidity;
+    // the full boot measures the crossing wake again
+    if (crossed(raw.temperature, stub.ref.temperature, stub.delta.temperature)
+        || crossed(raw.pressure, stub.ref.pressure, stub.delta.pressure)
+        || crossed(raw.humidity, stub.ref.humidity, stub.delta.humidity)) {
+        return false;
+    }
+    stub.armed = true;
+    return true;
+}
+
+void RTC_IRAM_ATTR sleep() {
+    esp_wake_stub_set_wakeup_time(stub.interval_us);
+    esp_wake_stub_sleep(&esp_wake_deep_sleep);
+}
+
+void drain(drain_cb_t cb) {
+    sensors::bme280_calib_t calib;
+    if (stub.count && sensors::bme280_cached_calibration(calib)) {
+        ESP_LOGI(TAG, "%d samples", stub.count);
+        for (size_t i = 0; i < stub.count; i++) {
+            // the crossing wake is measured again by this boot
+            if (stub.samples[i].boot_count != deepsleep::get_boot_count()) {
+                // the stub wakes are one interval apart, this boot started on the last one
+                const auto wakes = deepsleep::get_boot_count() - stub.samples[i].boot_count;
+                const auto age   = std::chrono::microseconds(wakes * stub.interval_us + esp_timer_get_time());
+                cb(stub.samples[i].boot_count, age, sensors::bme280_convert(calib, stub.samples[i].raw));
+            }
+        }
+    }
+    stub.count = 0;
+    stub.armed = false;
+}
+
+/*
+ * the local slope of the compensation at the reference turns the dead-band into raw counts,
+ * 1 count - any change
+ */
+static int32_t raw_delta(int32_t band_centi, float value_per_count) {
+    if (value_per_count <= 0) {
+        return 1;
+    }
+    return std::max<int32_t>(band_centi / 100.f / value_per_count, 1);
+}
+
+static sensors::bme280_raw_t raw_deltas(const sensors::bme280_calib_t& calib, const sensors::bme280_raw_t& ref) {
+    sensors::bme280_raw_t res = {};
+#if CONFIG_REPORT_DEADBAND
+    constexpr int32_t STEP = 256;
+    const auto        val  = sensors::bme280_convert(calib, ref);
+    auto              raw  = ref;
+    raw.temperature += STEP;
+    res.temperature = raw_delta(CONFIG_REPORT_DEADBAND_TEMPERATURE,
+        (sensors::bme280_convert(calib, raw).temperature - val.temperature) / STEP);
+    raw = ref;
+    raw.pressure += STEP;
+    // the pressure falls with the raw value
+    res.pressure = raw_delta(
+        CONFIG_REPORT_DEADBAND_PRESSURE, (val.pressure - sensors::bme280_convert(calib, raw).pressure) / STEP);
+    raw = ref;
+    raw.humidity += STEP;
+    res.humidity = raw_delta(
+        CONFIG_REPORT_DEADBAND_HUMIDITY, (sensors::bme280_convert(calib, raw).humidity - val.humidity) / STEP);
+#endif
+    return res;
+}
+
+void arm(std::chrono::seconds interval) {
+    stub.armed = false;
+    sensors::bme280_calib_t calib;
+    sensors::bme280_raw_t   ref;
+    if (!mqtt::outbox::empty() || !sensors::bme280_cached_calibration(calib) || !sensors::bme280_last_raw(ref)) {
+        return;
+    }
+    int64_t budget = CONFIG_WAKE_STUB_SAMPLES;
+    if (report::deadband_enabled()) {
+        budget = std::min<int64_t>(budget, report::until_heartbeat() / interval - 1);
+    } else {
+        budget = std::min<int64_t>(budget, batch::wakes_until_due());
+    }
+    if (budget <= 0) {
+        return;
+    }
+    const auto profile = sensors::bme280_profile();
+    stub.budget        = budget;
+    stub.count         = 0;
+    stub.ctrl_hum      = profile.humidity;
+    stub.ctrl_meas     = sensors::bme280_ctrl_meas(profile, BME280_MODE_FORCED);
+    stub.delay_us      = sensors::measurement_time(profile).count();
+    stub.interval_us   = std::chrono::microseconds(interval).count();
+    stub.ref           = ref;
+    stub.delta         = raw_deltas(calib, ref);
+    stub.armed         = true;
+    ESP_LOGI(TAG, "armed for %d wakes", stub.budget);
+}
+
+#else
+bool run(int /*boot_count*/) {
+    return false;
+}
+void sleep() {}
+void drain(drain_cb_t /*cb*/) {}
+void arm(std::chrono::seconds /*interval*/) {}
+#endif
+
+} // namespace wake_stub
@@ -0,0 +1,31 @@
+/*
+ * wake_stub.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: oleksandr
+ */
+
+#pragma once
+
+#include <chrono>
+#include "bme280_wrapper.hpp"
+
+/*
+ * BME280 pre-screening in the deep sleep wake stub.
+ * the stub takes a forced measurement over a bit-banged I2C and goes back to sleep,
+ * the full boot happens when the armed budget is used up or a dead-band is crossed
+ */
+namespace wake_stub {
+// RTC IRAM, true - the sample is stored and the chip can go back to sleep
+bool run(int boot_count);
+// RTC IRAM, does not return
+void sleep();
+
+// age - since the stub wake of the sample
+using drain_cb_t = void (*)(int boot_count, std::chrono::microseconds age, const sensors::bme280_t& val);
+
+// samples taken by the stub since the last full boot, the oldest first, the buffer is emptied
+void drain(drain_cb_t cb);
+// lets the stub handle the next wakes of the interval when nothing else needs the full boot
+void arm(std::chrono::seconds interval);
+} // namespace wake_stub
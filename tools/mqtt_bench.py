@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+"""Broker path benchmark: publish-to-ack latency, flush time and messages per second.
+
+proxy  - TCP proxy between the device (or `run`) and the broker, injects delay, jitter and drop.
+         each chunk is released --delay after its arrival, those in flight overlap. TCP retransmits
+         a lost segment, a dropped chunk is held for --rto on top of the delay.
+run    - host publisher with the CMQTTWrapper queue semantics (QoS 1, up to --window messages
+         waiting for PUBACK, flush waits for the empty queue), swept over message sizes and depths.
+         emulated numbers: the device's esp-mqtt and lwIP are not in the path, see `log` for those.
+log    - the same numbers from the device monitor output (mqtt_wrapper.cpp "sent"/"ack"/"flush" lines).
+broker - a stand-in broker where there is no mosquitto: CONNACK and PUBACK, nothing is delivered.
+
+tools/mqtt_bench.py proxy --listen 1884 --broker localhost:1883 --delay 20 --jitter 10 --drop 0.01
+tools/mqtt_bench.py run --broker localhost:1884 --sizes 64,512,2048 --depths 1,4,16 --window 4
+idf.py monitor | tee monitor.log; tools/mqtt_bench.py log < monitor.log
+tools/mqtt_bench.py broker --listen 1883
+"""
+import argparse
+import asyncio
+import random
+import re
+import statistics
+import struct
+import sys
+import time
+
+CONNECT = 0x10
+CONNACK = 0x20
+PUBLISH_QOS1 = 0x32
+PUBACK = 0x40
+DISCONNECT = 0xE0
+
+
+def host_port(text, default_port=1883):
+    host, _, port = text.rpartition(":")
+    return (host or "localhost", int(port)) if port.isdigit() else (text, default_port)
+
+
+def percentiles(values):
+    if not values:
+        return "n=0"
+    ordered = sorted(values)
+    pick = lambda p: ordered[min(len(ordered) - 1, int(p * len(ordered)))]
+    return (f"n={len(ordered)} p50={pick(0.50):.1f} p90={pick(0.90):.1f} p99={pick(0.99):.1f} "
+            f"max={ordered[-1]:.1f} mean={statistics.fmean(ordered):.1f}")
+
+
+# proxy
+
+
+async def pipe(reader, writer, args, rng):
+    # the reader stamps each chunk at its arrival, the writer releases it at arrival + delay: the chunks in flight
+    # overlap as on a real link. they keep their order, a chunk waits for the one before it
+    queue = asyncio.Queue()
+
+    async def receive():
+        deadline = 0.0
+        try:
+            while data := await reader.read(4096):
+                delay = args.delay + rng.uniform(-args.jitter, args.jitter)
+                if rng.random() < args.drop:
+                    delay += args.rto
+                deadline = max(deadline, time.monotonic() + max(0.0, delay) / 1000)
+                queue.put_nowait((deadline, data))
+        except ConnectionError:
+            pass
+        finally:
+            queue.put_nowait((0.0, b""))
+
+    async def send():
+        try:
+            while (item := await queue.get())[1]:
+                deadline, data = item
+                await asyncio.sleep(max(0.0, deadline - time.monotonic()))
+                writer.write(data)
+                await writer.drain()
+        except ConnectionError:
+            pass
+        finally:
+            writer.close()
+
+    await asyncio.gather(receive(), send())
+
+
+async def proxy(args):
+    rng = random.Random(args.seed)
+    broker = host_port(args.broker)
+
+    async def accept(client_reader, client_writer):
+        broker_reader, broker_writer = await asyncio.open_connection(*broker)
+        await asyncio.gather(pipe(client_reader, broker_writer, args, rng),
+                             pipe(broker_reader, client_writer, args, rng))
+
+    server = await asyncio.start_server(accept, "0.0.0.0", args.listen)
+    print(f"proxy :{args.listen} -> {broker[0]}:{broker[1]} delay={args.delay}ms "
+          f"jitter={args.jitter}ms drop={args.drop} rto={args.rto}ms", file=sys.stderr)
+    async with server:
+        await server.serve_forever()
+
+
+# MQTT 3.1.1 QoS 1 publisher
+
+
+def packet(kind, body):
+    length, encoded = len(body), bytearray()
+    while True:
+        byte, length = length % 128, length // 128
+        encoded.append(byte | (0x80 if length else 0))
+        if not length:
+            return bytes([kind]) + bytes(encoded) + body
+
+
+def utf8(text):
+    data = text.encode()
+    return struct.pack(">H", len(data)) + data
+
+
+async def read_packet(reader, flags=False):
+    kind = (await reader.readexactly(1))[0]
+    length, shift = 0, 0
+    while True:
+        byte = (await reader.readexactly(1))[0]
+        length |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return kind if flags else kind & 0xF0, await reader.readexactly(length)
+
+
+class Publisher:
+    def __init__(self, reader, writer, window):
+        self.reader, self.writer, self.window = reader, writer, window
+        self.queue, self.inflight, self.sent = [], {}, {}
+        self.latency = []
+        self.msg_id = 0
+        self.empty = asyncio.Event()
+        self.empty.set()
+
+    def publish(self, topic, message):
+        self.empty.clear()
+        self.queue.append((topic, message))
+        self.send_queue()
+
+    # keeps up to window messages waiting for the ack, as CMQTTWrapper::send_queue
+    def send_queue(self):
+        while self.queue and len(self.inflight) < self.window:
+            topic, message = self.queue.pop(0)
+            self.msg_id = self.msg_id % 0xFFFF + 1
+            self.inflight[self.msg_id] = time.monotonic()
+            self.writer.write(packet(PUBLISH_QOS1, utf8(topic) + struct.pack(">H", self.msg_id) + message))
+        if not self.queue and not self.inflight:
+            self.empty.set()
+
+    async def receive(self):
+        while True:
+            kind, body = await read_packet(self.reader)
+            if kind == PUBACK:
+                (msg_id,) = struct.unpack(">H", body[:2])
+                self.latency.append((time.monotonic() - self.inflight.pop(msg_id)) * 1000)
+                self.send_queue()
+
+    async def flush(self, timeout):
+        start = time.monotonic()
+        await asyncio.wait_for(self.empty.wait(), timeout)
+        return (time.monotonic() - start) * 1000
+
+
+async def connect(broker, client_id):
+    reader, writer = await asyncio.open_connection(*broker)
+    body = utf8("MQTT") + bytes([4, 0x02]) + struct.pack(">H", 60) + utf8(client_id)
+    writer.write(packet(CONNECT, body))
+    kind, body = await read_packet(reader)
+    if kind != CONNACK or body[1] != 0:
+        raise ConnectionError(f"connack {body.hex()}")
+    return reader, writer
+
+
+async def run(args):
+    broker = host_port(args.broker)
+    print("size depth window | publish-to-ack ms | flush ms | msg/s")
+    for size in map(int, args.sizes.split(",")):
+        for depth in map(int, args.depths.split(",")):
+            reader, writer = await connect(broker, f"mqtt_bench_{size}_{depth}")
+            publisher = Publisher(reader, writer, args.window)
+            receiver = asyncio.create_task(publisher.receive())
+            flush, total, count = [], 0.0, 0
+            start = time.monotonic()
+            # one round is a wake cycle: depth messages queued, then flush
+            for _ in range(args.rounds):
+                for _ in range(depth):
+                    publisher.publish(args.topic, bytes(size))
+                flush.append(await publisher.flush(args.timeout))
+                count += depth
+            total = time.monotonic() - start
+            receiver.cancel()
+            writer.write(packet(DISCONNECT, b""))
+            writer.close()
+            print(f"{size} {depth} {args.window} | {percentiles(publisher.latency)} | "
+                  f"{percentiles(flush)} | {count / total:.1f}")
+
+
+# broker stand-in
+
+
+async def broker(args):
+    async def session(reader, writer):
+        peer = writer.get_extra_info("peername")
+        try:
+            while True:
+                kind, body = await read_packet(reader, flags=True)
+                if kind & 0xF0 == CONNECT:
+                    writer.write(packet(CONNACK, b"\0\0"))
+                elif kind & 0xF0 == PUBLISH_QOS1 & 0xF0:
+                    (topic_len,) = struct.unpack_from(">H", body)
+                    qos = (kind >> 1) & 3
+                    if args.verbose:
+                        print(f"{peer} {body[2:2 + topic_len].decode()} qos={qos} retain={kind & 1} "
+                              f"len={len(body) - 2 - topic_len - (2 if qos else 0)}", file=sys.stderr)
+                    if qos == 1:
+                        writer.write(packet(PUBACK, body[2 + topic_len:4 + topic_len]))
+                elif kind & 0xF0 == DISCONNECT:
+                    break
+        except (asyncio.IncompleteReadError, ConnectionError):
+            pass
+        writer.close()
+
+    server = await asyncio.start_server(session, "0.0.0.0", args.listen)
+    print(f"broker :{args.listen}", file=sys.stderr)
+    async with server:
+        await server.serve_forever()
+
+
+# device monitor output
+
+SENT = re.compile(r"MQTT: sent seq=(\d+) msg_id=\d+ len=(\d+)")
+ACK = re.compile(r"MQTT: ack seq=(\d+) latency=(\d+)us inflight=(\d+)")
+FLUSH = re.compile(r"MQTT: flush (done|timeout) in (\d+)us")
+
+
+def log(args):
+    sizes, latency, flush, timeouts = {}, {}, [], 0
+    for line in sys.stdin:
+        if m := SENT.search(line):
+            sizes[m[1]] = int(m[2])
+        elif m := ACK.search(line):
+            latency.setdefault(sizes.get(m[1]), []).append(int(m[2]) / 1000)
+        elif m := FLUSH.search(line):
+            flush.append(int(m[2]) / 1000)
+            timeouts += m[1] == "timeout"
+    for size, values in sorted(latency.items(), key=lambda kv: kv[0] or 0):
+        print(f"len={size} publish-to-ack ms {percentiles(values)}")
+    print(f"flush ms {percentiles(flush)} timeouts={timeouts}")
+    acked = sum(len(values) for values in latency.values())
+    if flush:
+        print(f"msg/s while flushing {acked / (sum(flush) / 1000):.1f}")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+    p = commands.add_parser("proxy")
+    p.add_argument("--listen", type=int, default=1884)
+    p.add_argument("--broker", default="localhost:1883")
+    p.add_argument("--delay", type=float, default=0, help="one way, ms")
+    p.add_argument("--jitter", type=float, default=0, help="+-ms")
+    p.add_argument("--drop", type=float, default=0, help="chunk drop probability")
+    p.add_argument("--rto", type=float, default=200, help="retransmission delay of a dropped chunk, ms")
+    p.add_argument("--seed", type=int, default=1)
+    p = commands.add_parser("run")
+    p.add_argument("--broker", default="localhost:1884")
+    p.add_argument("--topic", default="bench/mqtt")
+    p.add_argument("--sizes", default="64,512,2048")
+    p.add_argument("--depths", default="1,4,16")
+    p.add_argument("--window", type=int, default=4, help="CONFIG_MQTT_INFLIGHT_WINDOW")
+    p.add_argument("--rounds", type=int, default=20)
+    p.add_argument("--timeout", type=float, default=30, help="flush timeout, s")
+    commands.add_parser("log")
+    p = commands.add_parser("broker")
+    p.add_argument("--listen", type=int, default=1883)
+    p.add_argument("-v", "--verbose", action="store_true", help="a line per PUBLISH")
+    args = parser.parse_args()
+    if args.command == "proxy":
+        asyncio.run(proxy(args))
+    elif args.command == "run":
+        asyncio.run(run(args))
+    elif args.command == "broker":
+        asyncio.run(broker(args))
+    else:
+        log(args)
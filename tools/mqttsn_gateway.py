@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""MQTT-SN 1.2 gateway stand-in for CONFIG_MQTTSN (main/mqtt_sn.cpp), prints "topic<TAB>payload" lines.
+
+Answers CONNECT, PUBLISH QoS 1 and DISCONNECT, accepts QoS -1 without a connection.
+Pre-defined topic ids map to the topics. A full topic ("sensors/<mac>") is used as it is: the
+ids of the nodes are unique (CONFIG_MQTTSN_TOPIC_ID_*), the only way to tell QoS -1 nodes apart.
+A bare topic gets the client id (MAC) of the connection as the suffix, as on TCP. QoS -1 has no
+client id, a bare topic is shared by the nodes and only the MAC in the payload tells them apart.
+
+tools/mqttsn_gateway.py --topic 1=advertisement/A0B1C2D3E4F5 --topic 2=sensors/A0B1C2D3E4F5 \
+    --topic 3=advertisement/A0B1C2D3E4F6 --topic 4=sensors/A0B1C2D3E4F6
+tools/mqttsn_gateway.py --topic 1=advertisement --topic 2=sensors --drop 0.1  # QoS 1
+tools/mqttsn_gateway.py --hex | cut -f2 | tools/payload_decode.py
+"""
+import argparse
+import random
+import socket
+import struct
+import sys
+
+CONNECT = 0x04
+CONNACK = 0x05
+PUBLISH = 0x0C
+PUBACK = 0x0D
+DISCONNECT = 0x18
+FLAG_DUP = 0x80
+FLAG_RETAIN = 0x10
+TOPIC_PREDEFINED = 0x01
+RC_ACCEPTED = 0x00
+RC_INVALID_TOPIC_ID = 0x02
+
+
+def packet(kind, body=b""):
+    if len(body) + 2 < 256:
+        return bytes([len(body) + 2, kind]) + body
+    return struct.pack(">BHB", 0x01, len(body) + 4, kind) + body
+
+
+def parse(data):
+    if data[0] == 0x01:
+        (length,) = struct.unpack_from(">H", data, 1)
+        return data[3], data[4:length]
+    return data[1], data[2:data[0]]
+
+
+def qos(flags):
+    return {0: 0, 1: 1, 2: 2, 3: -1}[(flags >> 5) & 3]
+
+
+def main(args):
+    topics = dict((int(k), v) for k, v in (item.split("=", 1) for item in args.topic))
+    rng = random.Random(args.seed)
+    clients, seen = {}, set()
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", args.port))
+    print(f"gateway :{args.port} topics {topics}", file=sys.stderr)
+    while True:
+        data, addr = sock.recvfrom(65535)
+        if rng.random() < args.drop:
+            print(f"{addr} dropped", file=sys.stderr)
+            continue
+        kind, body = parse(data)
+        if kind == CONNECT:
+            clients[addr] = body[4:].decode()
+            print(f"{addr} connect {clients[addr]}", file=sys.stderr)
+            sock.sendto(packet(CONNACK, bytes([RC_ACCEPTED])), addr)
+        elif kind == DISCONNECT:
+            print(f"{addr} disconnect {clients.pop(addr, '')}", file=sys.stderr)
+            sock.sendto(packet(DISCONNECT), addr)
+        elif kind == PUBLISH:
+            flags, topic_id, msg_id = struct.unpack_from(">BHH", body)
+            payload = body[5:]
+            level = qos(flags)
+            topic = topics.get(topic_id) if flags & 3 == TOPIC_PREDEFINED else None
+            if level == 1:
+                if addr not in clients:
+                    continue
+                rc = RC_ACCEPTED if topic else RC_INVALID_TOPIC_ID
+                sock.sendto(packet(PUBACK, struct.pack(">HHB", topic_id, msg_id, rc)), addr)
+                # the retransmission of the acknowledged one is not delivered twice
+                if flags & FLAG_DUP and (addr, msg_id) in seen:
+                    continue
+                seen.add((addr, msg_id))
+            if not topic:
+                print(f"{addr} unknown topic id {topic_id}", file=sys.stderr)
+                continue
+            if "/" not in topic:
+                if addr in clients:
+                    topic += "/" + clients[addr]
+                else:
+                    print(f"{addr} no client id, shared topic {topic}", file=sys.stderr)
+            if flags & FLAG_RETAIN:
+                print(f"{addr} retained {topic}", file=sys.stderr)
+            text = payload.hex() if args.hex else payload.decode(errors="replace")
+            print(f"{topic}\t{text}", flush=True)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=10000, help="CONFIG_MQTTSN_GATEWAY_PORT")
+    parser.add_argument("--topic", action="append", default=[], help="id=topic, pre-defined topic id")
+    parser.add_argument("--drop", type=float, default=0, help="datagram drop probability")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--hex", action="store_true", help="payload as hex, CONFIG_PAYLOAD_BINARY")
+    args = parser.parse_args()
+    if not args.topic:
+        args.topic = ["1=advertisement", "2=sensors"]
+    main(args)
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Decodes CONFIG_PAYLOAD_BINARY messages (layout in main/payload.cpp) to JSON.
+
+mosquitto_sub -t 'sensors/#' -h central.local -F '%x' | tools/payload_decode.py
+"""
+import json
+import struct
+import sys
+
+# the layout versions of main/payload.cpp this decoder reads
+VERSIONS = (1,)
+KIND_SENSORS = 1
+KIND_ADVERTISEMENT = 2
+FLAG_BME280 = 0x01
+FLAG_SHT3X = 0x02
+FLAG_LIGHT = 0x04
+FLAG_BATTERY = 0x08
+FLAG_TIME = 0x10
+
+
+def decode_sensors(data, pos):
+    res = {"mac": data[pos:pos + 6].hex().upper()}
+    res["seq"], rssi, hits, misses = struct.unpack_from("<IbII", data, pos + 6)
+    pos += 19
+    res["link"] = {"rssi": rssi, "fast_connect_hits": hits, "fast_connect_misses": misses}
+    (count,) = struct.unpack_from("<B", data, pos)
+    pos += 1
+    samples = []
+    for _ in range(count):
+        boot, flags = struct.unpack_from("<IB", data, pos)
+        pos += 5
+        sample = {"boot": boot}
+        if flags & FLAG_TIME:
+            (sample["time"],) = struct.unpack_from("<I", data, pos)
+            pos += 4
+        if flags & FLAG_BME280:
+            temperature, humidity, pressure = struct.unpack_from("<hHI", data, pos)
+            pos += 8
+            sample.update(temperature=temperature / 100, humidity=humidity / 100, pressure=pressure / 100)
+        if flags & FLAG_SHT3X:
+            temperature, humidity = struct.unpack_from("<hH", data, pos)
+            pos += 4
+            sample.update(sht3x_temperature=temperature / 100, sht3x_humidity=humidity / 100)
+        if flags & FLAG_LIGHT:
+            (light,) = struct.unpack_from("<I", data, pos)
+            pos += 4
+            sample["light"] = light / 100
+        if flags & FLAG_BATTERY:
+            (battery,) = struct.unpack_from("<H", data, pos)
+            pos += 2
+            sample["battery"] = battery / 1000
+        samples.append(sample)
+    res["samples"] = samples
+    return res
+
+
+def decode_advertisement(data, pos):
+    mac = data[pos:pos + 6]
+    ip = data[pos + 6:pos + 10]
+    res = {"ip": ".".join(str(b) for b in ip), "mac": mac.hex().upper()}
+    res["rssi"], name_len = struct.unpack_from("<bB", data, pos + 10)
+    pos += 12
+    res["app_name"] = data[pos:pos + name_len].decode()
+    return res
+
+
+def decode(data):
+    version, kind = struct.unpack_from("<BB", data)
+    if version not in VERSIONS:
+        raise ValueError(f"unsupported version {version}")
+    if kind == KIND_SENSORS:
+        return decode_sensors(data, 2)
+    if kind == KIND_ADVERTISEMENT:
+        return decode_advertisement(data, 2)
+    raise ValueError(f"unknown kind {kind}")
+
+
+if __name__ == "__main__":
+    for line in sys.stdin:
+        line = line.strip()
+        if line:
+            print(json.dumps(decode(bytes.fromhex(line))))
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Decodes the CONFIG_PAYLOAD_BINARY fixtures (tools/fixtures/payload_binary.jsonl) and compares the result.
+
+the fixtures are written by the host encoder (host/payload_fixtures.cpp) of main/payload.cpp, --encoder runs it
+and checks the file is up to date.
+tools/test_payload_decode.py [--encoder _gate_build/payload_fixtures]
+"""
+import argparse
+import json
+import pathlib
+import subprocess
+import sys
+
+sys.path.insert(0, str(pathlib.Path(__file__).parent))
+import payload_decode  # noqa: E402
+
+FIXTURES = pathlib.Path(__file__).parent / "fixtures" / "payload_binary.jsonl"
+TOLERANCE = 0.006  # the 0.01 step of the encoded values
+TOLERANCE_BATTERY = 0.0006  # V, 0.001 step
+
+
+def differences(got, expected, path=""):
+    if isinstance(expected, dict):
+        if not isinstance(got, dict) or got.keys() != expected.keys():
+            return [f"{path}: keys {sorted(got) if isinstance(got, dict) else got} != {sorted(expected)}"]
+        return [d for key in expected for d in differences(got[key], expected[key], f"{path}.{key}")]
+    if isinstance(expected, list):
+        if not isinstance(got, list) or len(got) != len(expected):
+            return [f"{path}: {got} != {expected}"]
+        return [d for i, (g, e) in enumerate(zip(got, expected)) for d in differences(g, e, f"{path}[{i}]")]
+    if isinstance(expected, float):
+        tolerance = TOLERANCE_BATTERY if path.endswith(".battery") else TOLERANCE
+        return [] if abs(got - expected) <= tolerance else [f"{path}: {got} != {expected}"]
+    return [] if got == expected else [f"{path}: {got!r} != {expected!r}"]
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--encoder", help="host/payload_fixtures executable, compared to the fixtures")
+    args = parser.parse_args()
+
+    text = FIXTURES.read_text()
+    failed = 0
+    if args.encoder:
+        encoded = subprocess.run([args.encoder], check=True, capture_output=True, text=True).stdout
+        if encoded != text:
+            print(f"{FIXTURES} is out of date with main/payload.cpp: {args.encoder} > {FIXTURES}")
+            failed += 1
+
+    fixtures = [json.loads(line) for line in text.splitlines() if line.strip()]
+    for fixture in fixtures:
+        try:
+            errors = differences(payload_decode.decode(bytes.fromhex(fixture["hex"])), fixture["decoded"])
+        except (ValueError, IndexError, KeyError) as err:
+            errors = [repr(err)]
+        print(f"{'FAILED' if errors else 'ok':6} {fixture['name']}")
+        for error in errors:
+            print(f"       {error}")
+        failed += bool(errors)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())